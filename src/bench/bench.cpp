@@ -0,0 +1,897 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+/**
+ * Micro benchmarks of the storage and execution layers, run as
+ *   wsdb_bench [name ...]
+ * which runs the named benchmarks, or all of them without a name. The benchmarks that need files work on databases
+ * created in a scratch directory, removed at exit, under the directory named by the WSDB_BENCH_DIR environment
+ * variable or else the system temporary directory, which may not support O_DIRECT. WSDB_BENCH_ROWS sets the rows of
+ * the table the mmap benchmark scans, e.g. to compare on a table larger than the memory
+ */
+
+#include <unistd.h>
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "execution/executor_aggregate_vec.h"
+#include "execution/executor_insert.h"
+#include "execution/executor_seqscan.h"
+#include "storage/buffer/buffer_pool_manager.h"
+#include "storage/buffer/replacer/replacer.h"
+#include "storage/disk/checksum.h"
+#include "system/table/table_manager.h"
+
+namespace wsdb {
+namespace {
+
+constexpr size_t  BENCH_POOL_SIZE = 4096;
+constexpr size_t  BENCH_REC_NUM   = 200000;
+constexpr size_t  BENCH_GROUP_NUM = 20000;
+// runs of a measurement of which the fastest is reported
+constexpr size_t  BENCH_ROUNDS = 5;
+// pages of the files read by the I/O benchmarks
+constexpr size_t  BENCH_FILE_PAGES = 16384;
+const std::string BENCH_DB     = "bench";
+const std::string BENCH_TABLE  = "t";
+
+/**
+ * @return nanoseconds fn took
+ */
+auto Time(const std::function<void()> &fn) -> int64_t
+{
+  auto start = std::chrono::steady_clock::now();
+  fn();
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * Print the time of ops operations and the time per operation
+ */
+void Print(const std::string &name, size_t ops, int64_t ns)
+{
+  fmt::print("{:<24} {:>10} ops {:>12.3f} ms {:>10.1f} ns/op\n", name, ops, ns / 1e6, static_cast<double>(ns) / ops);
+}
+
+/**
+ * Time fn, which does ops operations, and print the time per operation
+ */
+auto Report(const std::string &name, size_t ops, const std::function<void()> &fn) -> int64_t
+{
+  auto ns = Time(fn);
+  Print(name, ops, ns);
+  return ns;
+}
+
+struct AlignedPagesDeleter
+{
+  void operator()(char *pages) const { operator delete[](pages, std::align_val_t(PAGE_SIZE)); }
+};
+// page buffers aligned like the frames, so that they can be read from and written to O_DIRECT files
+using AlignedPages = std::unique_ptr<char[], AlignedPagesDeleter>;
+
+auto AllocatePages(size_t page_num) -> AlignedPages
+{
+  return AlignedPages(new (std::align_val_t(PAGE_SIZE)) char[page_num * PAGE_SIZE]());
+}
+
+auto MakeField(const std::string &name, FieldType type, size_t size) -> RTField
+{
+  RTField field;
+  field.field_.field_name_ = name;
+  field.field_.field_type_ = type;
+  field.field_.field_size_ = size;
+  return field;
+}
+
+/**
+ * Write system calls of the process so far as counted in /proc/self/io, 0 if it is not available
+ */
+auto WriteSyscalls() -> uint64_t
+{
+  std::ifstream in("/proc/self/io");
+  std::string   key;
+  uint64_t      value;
+  while (in >> key >> value) {
+    if (key == "syscw:") {
+      return value;
+    }
+  }
+  return 0;
+}
+
+void Check(const std::string &name, size_t rows, size_t expected)
+{
+  if (rows != expected) {
+    WSDB_FETAL(fmt::format("{}: {} rows, expected {}", name, rows, expected));
+  }
+}
+
+/**
+ * Page accesses of an OLTP workload interrupted by scans: runs of 50k accesses of which 80% go to a hot set of half
+ * as many pages as frames and the rest to any of the other pages, each run followed by a scan of twice as many
+ * pages as frames
+ */
+auto MakeReplacerTrace(size_t frame_num, size_t ops) -> std::vector<page_id_t>
+{
+  const size_t           page_num = 16 * frame_num;
+  const size_t           hot_num  = frame_num / 2;
+  std::vector<page_id_t> trace;
+  trace.reserve(ops);
+  std::mt19937 rng(42);
+  size_t       scan_cursor = 0;
+  while (trace.size() < ops) {
+    for (size_t i = 0; i < 50000 && trace.size() < ops; ++i) {
+      auto pid = rng() % 10 < 8 ? rng() % hot_num : hot_num + rng() % (page_num - hot_num);
+      trace.push_back(static_cast<page_id_t>(pid));
+    }
+    for (size_t i = 0; i < 2 * frame_num && trace.size() < ops; ++i) {
+      trace.push_back(static_cast<page_id_t>(hot_num + scan_cursor++ % (page_num - hot_num)));
+    }
+  }
+  return trace;
+}
+
+/**
+ * Replay the trace on BENCH_POOL_SIZE frames managed by the replacer as the buffer pool does: a hit pins and unpins
+ * the frame of the page, a miss takes a free frame or evicts a victim first
+ */
+void BenchReplacer(const std::string &name, const std::vector<page_id_t> &trace)
+{
+  auto                                      replacer = Replacer::Create(name, BENCH_POOL_SIZE, REPLACER_LRU_K);
+  std::unordered_map<page_id_t, frame_id_t> page_frames;
+  std::vector<page_id_t>                    frame_pages(BENCH_POOL_SIZE, INVALID_PAGE_ID);
+  size_t                                    used = 0;
+  size_t                                    hits = 0;
+  Report(name, trace.size(), [&]() {
+    for (auto pid : trace) {
+      frame_id_t fid;
+      if (auto it = page_frames.find(pid); it != page_frames.end()) {
+        fid = it->second;
+        hits++;
+      } else {
+        if (used < BENCH_POOL_SIZE) {
+          fid = static_cast<frame_id_t>(used++);
+        } else if (replacer->Victim(&fid)) {
+          page_frames.erase(frame_pages[fid]);
+        } else {
+          WSDB_FETAL("no victim");
+        }
+        page_frames[pid] = fid;
+        frame_pages[fid] = pid;
+      }
+      replacer->Pin(fid);
+      replacer->Unpin(fid);
+    }
+  });
+  fmt::print("{:<24} {:>10.3f} hit ratio\n", name, static_cast<double>(hits) / trace.size());
+}
+
+void BenchReplacers()
+{
+  auto trace = MakeReplacerTrace(BENCH_POOL_SIZE, 2000000);
+  for (const auto &name : {"LRUReplacer", "LRUKReplacer", "ClockReplacer"}) {
+    BenchReplacer(name, trace);
+  }
+}
+
+void BenchChecksum()
+{
+  constexpr size_t  pages = 200000;
+  std::vector<char> page(PAGE_SIZE);
+  std::mt19937      rng(42);
+  for (auto &c : page) {
+    c = static_cast<char>(rng());
+  }
+  uint32_t crc = 0;
+  Report("checksum", pages, [&]() {
+    for (size_t i = 0; i < pages; ++i) {
+      StampPageChecksum(page.data());
+      crc ^= PageChecksum(page.data());
+    }
+  });
+  if (!VerifyPageChecksum(page.data())) {
+    WSDB_FETAL(fmt::format("checksum mismatch {}", crc));
+  }
+}
+
+/**
+ * The scratch directory, which is the working directory of the benchmarks while it lives
+ */
+class ScratchDirectory
+{
+public:
+  ScratchDirectory()
+  {
+    auto *base = std::getenv("WSDB_BENCH_DIR");
+    dir_       = (base != nullptr ? std::filesystem::path(base) : std::filesystem::temp_directory_path()) /
+           fmt::format("wsdb_bench_{}", getpid());
+    std::filesystem::create_directories(dir_);
+    std::filesystem::current_path(dir_);
+  }
+
+  ~ScratchDirectory()
+  {
+    std::filesystem::current_path(dir_.parent_path());
+    std::filesystem::remove_all(dir_);
+  }
+
+  DISABLE_COPY_MOVE_AND_ASSIGN(ScratchDirectory)
+
+private:
+  std::filesystem::path dir_;
+};
+
+/**
+ * A database in the scratch directory with a table of (g int, v int, f float), every database has a directory of its
+ * own so that several can be compared side by side
+ */
+class BenchDatabase
+{
+public:
+  explicit BenchDatabase(bool page_checksum = PAGE_CHECKSUM, size_t pool_size = BENCH_POOL_SIZE,
+      size_t shard_num = BUFFER_POOL_SHARD_NUM, bool direct_io = false, StorageModel storage_model = NARY_MODEL)
+      : db_name_(fmt::format("{}_{}", BENCH_DB, db_num_++)), direct_io_(direct_io), storage_model_(storage_model)
+  {
+    std::filesystem::create_directories(db_name_);
+
+    disk_manager_        = std::make_unique<DiskManager>(page_checksum);
+    buffer_pool_manager_ = std::make_unique<BufferPoolManager>(
+        disk_manager_.get(), nullptr, REPLACER_LRU_K, pool_size, false, shard_num);
+    table_manager_ = std::make_unique<TableManager>(disk_manager_.get(), buffer_pool_manager_.get(), direct_io);
+
+    RecordSchema schema({MakeField("g", TYPE_INT, sizeof(int32_t)),
+        MakeField("v", TYPE_INT, sizeof(int32_t)),
+        MakeField("f", TYPE_FLOAT, sizeof(float))});
+    table_manager_->CreateTable(db_name_, BENCH_TABLE, schema, storage_model_);
+    table_ = table_manager_->OpenTable(db_name_, BENCH_TABLE, storage_model_);
+  }
+
+  ~BenchDatabase()
+  {
+    for (auto fid : files_) {
+      CloseFile(fid);
+    }
+    table_manager_->CloseTable(db_name_, *table_);
+    table_.reset();
+    table_manager_.reset();
+    buffer_pool_manager_.reset();
+    disk_manager_.reset();
+    std::filesystem::remove_all(db_name_);
+  }
+
+  DISABLE_COPY_MOVE_AND_ASSIGN(BenchDatabase)
+
+  [[nodiscard]] auto GetDiskManager() const -> DiskManager * { return disk_manager_.get(); }
+
+  [[nodiscard]] auto GetBufferPoolManager() const -> BufferPoolManager * { return buffer_pool_manager_.get(); }
+
+  [[nodiscard]] auto GetTable() const -> TableHandle * { return table_.get(); }
+
+  /**
+   * Open a file of the database for page I/O, it is created if it does not exist and closed with the database
+   */
+  auto OpenFile(const std::string &name, bool direct_io = false) -> file_id_t
+  {
+    auto fname = (std::filesystem::path(db_name_) / name).string();
+    if (!DiskManager::FileExists(fname)) {
+      DiskManager::CreateFile(fname);
+    }
+    auto fid = disk_manager_->OpenFile(fname, direct_io);
+    files_.push_back(fid);
+    return fid;
+  }
+
+  /**
+   * Drop the pages of a file opened by OpenFile from the pool and close it
+   */
+  void CloseFile(file_id_t fid)
+  {
+    buffer_pool_manager_->DeleteAllPages(fid);
+    disk_manager_->CloseFile(fid);
+    files_.erase(std::find(files_.begin(), files_.end(), fid));
+  }
+
+  /**
+   * rec_num random rows of the table, g takes about BENCH_GROUP_NUM values and v is the row number counted from
+   * first_row
+   */
+  [[nodiscard]] auto MakeRecords(size_t rec_num, size_t first_row = 0) const -> std::vector<RecordUptr>
+  {
+    std::vector<RecordUptr> records;
+    records.reserve(rec_num);
+    std::mt19937 rng(42 + first_row);
+    for (size_t i = first_row; i < first_row + rec_num; ++i) {
+      std::vector<ValueSptr> values{ValueFactory::CreateIntValue(static_cast<int32_t>(rng() % BENCH_GROUP_NUM)),
+          ValueFactory::CreateIntValue(static_cast<int32_t>(i)),
+          ValueFactory::CreateFloatValue(static_cast<float>(rng() % 1000) / 10)};
+      records.push_back(std::make_unique<Record>(&table_->GetSchema(), values, INVALID_RID));
+    }
+    return records;
+  }
+
+  /**
+   * Insert rec_num random rows with InsertExecutors of up to a million rows each
+   */
+  void Fill(size_t rec_num)
+  {
+    constexpr size_t batch_size = 1000000;
+    for (size_t row = 0; row < rec_num; row += batch_size) {
+      InsertExecutor insert(table_.get(), {}, MakeRecords(std::min(batch_size, rec_num - row), row));
+      insert.Next();
+    }
+  }
+
+  /**
+   * Write the dirty pages of the table
+   */
+  void Flush() { buffer_pool_manager_->FlushAllPages(table_->GetTableId()); }
+
+  /**
+   * Open the table read-only through a memory mapping from the next Reopen on, see TableHandle::IsMapped
+   */
+  void MapTable()
+  {
+    table_manager_ = std::make_unique<TableManager>(disk_manager_.get(),
+        buffer_pool_manager_.get(),
+        direct_io_,
+        std::unordered_set<std::string>{BENCH_TABLE});
+  }
+
+  /**
+   * Close and open the table again, which writes its pages and drops them from the pool, so that the next scan
+   * reads them from disk
+   */
+  auto Reopen() -> TableHandle *
+  {
+    table_manager_->CloseTable(db_name_, *table_);
+    table_ = table_manager_->OpenTable(db_name_, BENCH_TABLE, storage_model_);
+    return table_.get();
+  }
+
+private:
+  static inline size_t db_num_{0};
+
+  std::string                        db_name_;
+  bool                               direct_io_;
+  StorageModel                       storage_model_;
+  std::unique_ptr<DiskManager>       disk_manager_;
+  std::unique_ptr<BufferPoolManager> buffer_pool_manager_;
+  std::unique_ptr<TableManager>      table_manager_;
+  TableHandleUptr                    table_;
+  std::vector<file_id_t>             files_;
+};
+
+/**
+ * The pages of a file read in random order by a ReadPage loop and by ReadPagesAsync batches of 32 pages with 8 batches
+ * in flight, through the OS page cache and with O_DIRECT
+ */
+void BenchAsyncRead()
+{
+  constexpr size_t batch_size = 32;
+  constexpr size_t depth      = 8;
+  BenchDatabase    db;
+  auto            *disk_manager = db.GetDiskManager();
+  auto             pages        = AllocatePages(batch_size * depth);
+
+  std::vector<page_id_t> pids(BENCH_FILE_PAGES);
+  std::iota(pids.begin(), pids.end(), 0);
+  auto fid = db.OpenFile("pages");
+  for (size_t i = 0; i < pids.size(); i += batch_size) {
+    std::vector<page_id_t> batch(pids.begin() + i, pids.begin() + i + batch_size);
+    std::vector<char *>    bufs(batch_size, pages.get());
+    disk_manager->WritePages(fid, batch, bufs);
+  }
+  db.CloseFile(fid);
+  std::shuffle(pids.begin(), pids.end(), std::mt19937(42));
+
+  for (bool direct_io : {false, true}) {
+    fid = db.OpenFile("pages", direct_io);
+    const std::string mode = direct_io ? "direct" : "buffered";
+    Report(fmt::format("read_page/{}", mode), pids.size(), [&]() {
+      for (auto pid : pids) {
+        disk_manager->ReadPage(fid, pid, pages.get());
+      }
+    });
+    Report(fmt::format("read_async/{}", mode), pids.size(), [&]() {
+      // batch i reads into slot i % depth, whose previous batch is waited for before
+      std::deque<std::future<void>> pending;
+      for (size_t i = 0; i < pids.size(); i += batch_size) {
+        if (pending.size() == depth) {
+          pending.front().get();
+          pending.pop_front();
+        }
+        std::vector<page_id_t> batch(pids.begin() + i, pids.begin() + i + batch_size);
+        std::vector<char *>    bufs;
+        for (size_t j = 0; j < batch_size; ++j) {
+          bufs.push_back(pages.get() + ((i / batch_size) % depth * batch_size + j) * PAGE_SIZE);
+        }
+        pending.push_back(disk_manager->ReadPagesAsync(fid, batch, bufs));
+      }
+      for (auto &future : pending) {
+        future.get();
+      }
+    });
+    db.CloseFile(fid);
+  }
+}
+
+/**
+ * Fetches and unpins of random pages of a file with twice as many pages as the pool has frames, so that about half of
+ * them evict a victim, for pools of 1k to 128k frames. The file is empty and its pages read as zeros, which leaves the
+ * cost of a miss to the pool
+ */
+void BenchPoolSize()
+{
+  constexpr size_t ops = 1000000;
+  for (size_t pool_size = 1024; pool_size <= 131072; pool_size *= 2) {
+    BenchDatabase db(false, pool_size);
+    auto         *buffer_pool_manager = db.GetBufferPoolManager();
+    auto          fid                 = db.OpenFile("pages");
+    for (size_t pid = 0; pid < pool_size; ++pid) {
+      buffer_pool_manager->FetchPage(fid, static_cast<page_id_t>(pid));
+      buffer_pool_manager->UnpinPage(fid, static_cast<page_id_t>(pid), false);
+    }
+    std::mt19937 rng(42);
+    Report(fmt::format("pool_size/{}", pool_size), ops, [&]() {
+      for (size_t i = 0; i < ops; ++i) {
+        auto pid = static_cast<page_id_t>(rng() % (2 * pool_size));
+        buffer_pool_manager->FetchPage(fid, pid);
+        buffer_pool_manager->UnpinPage(fid, pid, false);
+      }
+    });
+  }
+}
+
+/**
+ * 1 to 32 threads fetch and unpin random pages that are all in the pool, with the pool in one shard and in
+ * BUFFER_POOL_SHARD_NUM shards. Every thread does the same number of operations, so the time per operation is the
+ * inverse of the throughput
+ */
+void BenchThreads()
+{
+  constexpr size_t ops_per_thread = 200000;
+  for (size_t shard_num : {size_t{1}, BUFFER_POOL_SHARD_NUM}) {
+    BenchDatabase db(false, BENCH_POOL_SIZE, shard_num);
+    auto         *buffer_pool_manager = db.GetBufferPoolManager();
+    auto          fid                 = db.OpenFile("pages");
+    for (size_t pid = 0; pid < BENCH_POOL_SIZE; ++pid) {
+      buffer_pool_manager->FetchPage(fid, static_cast<page_id_t>(pid));
+      buffer_pool_manager->UnpinPage(fid, static_cast<page_id_t>(pid), false);
+    }
+    for (size_t thread_num = 1; thread_num <= 32; thread_num *= 2) {
+      Report(fmt::format("threads/{}/shards_{}", thread_num, shard_num), thread_num * ops_per_thread, [&]() {
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < thread_num; ++t) {
+          threads.emplace_back([buffer_pool_manager, fid, t]() {
+            std::mt19937 rng(t);
+            for (size_t i = 0; i < ops_per_thread; ++i) {
+              auto pid = static_cast<page_id_t>(rng() % BENCH_POOL_SIZE);
+              buffer_pool_manager->FetchPage(fid, pid);
+              buffer_pool_manager->UnpinPage(fid, pid, false);
+            }
+          });
+        }
+        for (auto &thread : threads) {
+          thread.join();
+        }
+      });
+    }
+  }
+}
+
+/**
+ * A scan of a file with four times as many pages as the pool has frames, each page it reads followed by a fetch of
+ * a random page of a hot set that fills half of the pool, with and without a BULK_READ ring for the scan. The hit
+ * ratio of the hot set shows how much of it the scan evicts
+ */
+void BenchMixed()
+{
+  constexpr size_t hot_num  = BENCH_POOL_SIZE / 2;
+  constexpr size_t scan_num = 4 * BENCH_POOL_SIZE;
+  for (bool ring : {false, true}) {
+    BenchDatabase db(false);
+    auto         *buffer_pool_manager = db.GetBufferPoolManager();
+    auto          hot_fid             = db.OpenFile("hot");
+    auto          scan_fid            = db.OpenFile("scan");
+    for (size_t pid = 0; pid < hot_num; ++pid) {
+      buffer_pool_manager->FetchPage(hot_fid, static_cast<page_id_t>(pid));
+      buffer_pool_manager->UnpinPage(hot_fid, static_cast<page_id_t>(pid), false);
+    }
+    auto         strategy = ring ? BufferAccessStrategy::Create(BufferAccessType::BULK_READ) : nullptr;
+    auto         before   = buffer_pool_manager->GetFileStats()[hot_fid];
+    std::mt19937 rng(42);
+    const std::string name = ring ? "mixed/ring" : "mixed/no_ring";
+    Report(name, scan_num, [&]() {
+      for (size_t pid = 0; pid < scan_num; ++pid) {
+        buffer_pool_manager->FetchPage(scan_fid, static_cast<page_id_t>(pid), strategy.get());
+        buffer_pool_manager->UnpinPage(scan_fid, static_cast<page_id_t>(pid), false);
+        auto hot_pid = static_cast<page_id_t>(rng() % hot_num);
+        buffer_pool_manager->FetchPage(hot_fid, hot_pid);
+        buffer_pool_manager->UnpinPage(hot_fid, hot_pid, false);
+      }
+    });
+    auto after = buffer_pool_manager->GetFileStats()[hot_fid];
+    auto hits  = after.hits_ - before.hits_;
+    fmt::print("{:<24} {:>10.3f} hot set hit ratio\n",
+        name,
+        static_cast<double>(hits) / static_cast<double>(hits + after.misses_ - before.misses_));
+  }
+}
+
+/**
+ * @return the rows of the table of the mmap benchmark, WSDB_BENCH_ROWS if it is set
+ */
+auto MappedTableRows() -> size_t
+{
+  auto *rows = std::getenv("WSDB_BENCH_ROWS");
+  return rows != nullptr ? std::stoul(rows) : BENCH_REC_NUM * 5;
+}
+
+/**
+ * Rows of the table read through the row interface of SeqScanExecutor
+ */
+auto ScanRows(TableHandle *table) -> size_t
+{
+  SeqScanExecutor scan(table);
+  size_t          rows = 0;
+  for (scan.Init(); !scan.IsEnd(); scan.Next()) {
+    rows += scan.GetRecordView().IsNull(0) ? 0 : 1;
+  }
+  return rows;
+}
+
+/**
+ * Rows of the table read a record at a time, GetNextRID and GetRecord both fetch the page of every row as
+ * SeqScanExecutor did before it read a page at a time
+ */
+auto ScanRids(TableHandle *table) -> size_t
+{
+  auto   strategy = table->CreateScanStrategy();
+  size_t rows     = 0;
+  for (auto rid = table->GetFirstRID(strategy.get()); rid != INVALID_RID; rid = table->GetNextRID(rid, strategy.get())) {
+    rows += table->GetRecord(rid, strategy.get()) != nullptr ? 1 : 0;
+  }
+  return rows;
+}
+
+/**
+ * Rows of the table read through the batch interface of SeqScanExecutor
+ */
+auto ScanBatches(TableHandle *table) -> size_t
+{
+  SeqScanExecutor scan(table);
+  size_t          rows = 0;
+  scan.InitBatch();
+  for (auto chunk = scan.NextBatch(EXECUTOR_BATCH_SIZE); chunk != nullptr; chunk = scan.NextBatch(EXECUTOR_BATCH_SIZE)) {
+    rows += chunk->GetSize();
+  }
+  return rows;
+}
+
+/**
+ * A bulk insert into the write-back pool followed by a flush of the table, against writing the page of every row
+ * as the write-through UnpinPage used to. The page writes and write system calls of both are printed
+ */
+void BenchBulkInsert()
+{
+  for (bool write_through : {false, true}) {
+    BenchDatabase db;
+    auto         *table               = db.GetTable();
+    auto         *buffer_pool_manager = db.GetBufferPoolManager();
+    auto          records             = db.MakeRecords(BENCH_REC_NUM);
+    auto          writes              = buffer_pool_manager->GetStats().Snapshot().dirty_writes_;
+    auto          syscalls            = WriteSyscalls();
+    const std::string name = write_through ? "bulk_insert/flush_row" : "bulk_insert/write_back";
+    if (write_through) {
+      Report(name, BENCH_REC_NUM, [&]() {
+        for (const auto &record : records) {
+          auto rid = table->InsertRecord(*record);
+          buffer_pool_manager->FlushPage(table->GetTableId(), rid.PageID());
+        }
+      });
+    } else {
+      InsertExecutor insert(table, {}, std::move(records));
+      Report(name, BENCH_REC_NUM, [&]() {
+        insert.Next();
+        buffer_pool_manager->FlushAllPages(table->GetTableId());
+      });
+    }
+    fmt::print("{:<24} {:>10} page writes {:>10} write syscalls\n",
+        name,
+        buffer_pool_manager->GetStats().Snapshot().dirty_writes_ - writes,
+        WriteSyscalls() - syscalls);
+  }
+}
+
+/**
+ * Scans of the tables of the databases, each with a label, through the row and the batch interface. Every round
+ * reopens the tables, so that their pages are read from disk, and scans them one after the other in an order that
+ * rotates every round, since the scans that run later in a round tend to be faster
+ * @return the fastest time of each database per scan interface
+ */
+auto CompareScans(const std::vector<std::pair<std::string, BenchDatabase *>> &dbs, size_t rec_num)
+    -> std::vector<std::pair<std::string, std::vector<int64_t>>>
+{
+  std::vector<std::pair<std::string, std::function<size_t(TableHandle *)>>> scans{
+      {"scan_row", ScanRows}, {"scan_batch", ScanBatches}};
+  std::vector<std::pair<std::string, std::vector<int64_t>>> result;
+  for (const auto &scan : scans) {
+    std::vector<int64_t> ns(dbs.size(), std::numeric_limits<int64_t>::max());
+    for (size_t round = 0; round < dbs.size() * BENCH_ROUNDS; ++round) {
+      for (size_t i = 0; i < dbs.size(); ++i) {
+        auto   db_idx = (round + i) % dbs.size();
+        auto  *table  = dbs[db_idx].second->Reopen();
+        size_t rows   = 0;
+        ns[db_idx]    = std::min(ns[db_idx], Time([&]() { rows = scan.second(table); }));
+        Check(scan.first, rows, rec_num);
+      }
+    }
+    for (size_t i = 0; i < dbs.size(); ++i) {
+      Print(fmt::format("{}/{}", scan.first, dbs[i].first), rec_num, ns[i]);
+    }
+    result.emplace_back(scan.first, std::move(ns));
+  }
+  return result;
+}
+
+/**
+ * Scans of a table with page checksums off and of one with them on, which are verified as the pages are read from
+ * disk
+ */
+void BenchScan()
+{
+  constexpr size_t rec_num = BENCH_REC_NUM * 5;
+  BenchDatabase    checksum_off(false);
+  BenchDatabase    checksum_on(true);
+  checksum_off.Fill(rec_num);
+  checksum_on.Fill(rec_num);
+  for (const auto &[name, ns] : CompareScans({{"checksum_off", &checksum_off}, {"checksum_on", &checksum_on}}, rec_num)) {
+    fmt::print("{:<24} {:>+10.1f} %\n",
+        fmt::format("{}/checksum_cost", name),
+        static_cast<double>(ns[1] - ns[0]) * 100 / ns[0]);
+  }
+}
+
+/**
+ * Bulk inserts followed by a flush and scans of a table with buffered I/O and of one with O_DIRECT, on which the
+ * scans read every page from the device instead of the OS page cache
+ */
+void BenchDirectIO()
+{
+  constexpr size_t rec_num = BENCH_REC_NUM * 5;
+  BenchDatabase    buffered(PAGE_CHECKSUM, BENCH_POOL_SIZE, BUFFER_POOL_SHARD_NUM, false);
+  BenchDatabase    direct(PAGE_CHECKSUM, BENCH_POOL_SIZE, BUFFER_POOL_SHARD_NUM, true);
+  for (auto [name, db] : {std::make_pair("bulk_insert/buffered", &buffered), std::make_pair("bulk_insert/direct", &direct)}) {
+    InsertExecutor insert(db->GetTable(), {}, db->MakeRecords(rec_num));
+    Report(name, rec_num, [&insert, db = db]() {
+      insert.Next();
+      db->Flush();
+    });
+  }
+  CompareScans({{"buffered", &buffered}, {"direct", &direct}}, rec_num);
+}
+
+/**
+ * Rows per second of cold scans that fetch the page of a row for every row and of the page-at-a-time SeqScanExecutor,
+ * the rounds alternate between the two
+ */
+void BenchScanPage()
+{
+  constexpr size_t rec_num = BENCH_REC_NUM * 5;
+  BenchDatabase    db(PAGE_CHECKSUM, BENCH_POOL_SIZE / 4);
+  db.Fill(rec_num);
+  std::vector<std::pair<std::string, std::function<size_t(TableHandle *)>>> scans{
+      {"scan_rid", ScanRids}, {"scan_page", ScanRows}};
+  std::vector<int64_t> ns(scans.size(), std::numeric_limits<int64_t>::max());
+  for (size_t round = 0; round < scans.size() * BENCH_ROUNDS; ++round) {
+    for (size_t i = 0; i < scans.size(); ++i) {
+      auto   scan_idx = (round + i) % scans.size();
+      auto  *table    = db.Reopen();
+      size_t rows     = 0;
+      ns[scan_idx]    = std::min(ns[scan_idx], Time([&]() { rows = scans[scan_idx].second(table); }));
+      Check(scans[scan_idx].first, rows, rec_num);
+    }
+  }
+  for (size_t i = 0; i < scans.size(); ++i) {
+    Print(scans[i].first, rec_num, ns[i]);
+    fmt::print("{:<24} {:>10.2f} Mrows/s\n", scans[i].first, static_cast<double>(rec_num) * 1e3 / ns[i]);
+  }
+}
+
+/**
+ * SUM(v) over the rows of an N-ary table read through the row interface of SeqScanExecutor and over the chunks of the
+ * N-ary table and of a PAX table with the same rows, whose pages are read a column at a time. The tables stay in the
+ * pool, so that the time is that of decoding the pages
+ */
+void BenchPax()
+{
+  constexpr size_t rec_num = BENCH_REC_NUM * 5;
+  BenchDatabase    nary;
+  BenchDatabase    pax(PAGE_CHECKSUM, BENCH_POOL_SIZE, BUFFER_POOL_SHARD_NUM, false, PAX_MODEL);
+  nary.Fill(rec_num);
+  pax.Fill(rec_num);
+  auto sum_rows = [](TableHandle *table) {
+    SeqScanExecutor scan(table);
+    int64_t         sum = 0;
+    for (scan.Init(); !scan.IsEnd(); scan.Next()) {
+      sum += *reinterpret_cast<const int32_t *>(scan.GetRecordView().GetFieldData(1));
+    }
+    return sum;
+  };
+  auto sum_chunks = [](TableHandle *table) {
+    SeqScanExecutor scan(table);
+    int64_t         sum = 0;
+    scan.InitBatch();
+    for (auto chunk = scan.NextBatch(EXECUTOR_BATCH_SIZE); chunk != nullptr; chunk = scan.NextBatch(EXECUTOR_BATCH_SIZE)) {
+      const auto *v = chunk->GetCol(1).GetData<int32_t>();
+      for (size_t row = 0; row < chunk->GetSize(); ++row) {
+        sum += v[chunk->GetRowIndex(row)];
+      }
+    }
+    return sum;
+  };
+  std::vector<std::pair<std::string, std::function<int64_t()>>> scans{
+      {"sum_v/nary_row", [&]() { return sum_rows(nary.GetTable()); }},
+      {"sum_v/nary_batch", [&]() { return sum_chunks(nary.GetTable()); }},
+      {"sum_v/pax_batch", [&]() { return sum_chunks(pax.GetTable()); }}};
+  // v is the row number
+  const auto expected = static_cast<int64_t>(rec_num) * (static_cast<int64_t>(rec_num) - 1) / 2;
+  for (const auto &scan : scans) {
+    int64_t ns = std::numeric_limits<int64_t>::max();
+    for (size_t round = 0; round < BENCH_ROUNDS; ++round) {
+      int64_t sum = 0;
+      ns          = std::min(ns, Time([&]() { sum = scan.second(); }));
+      if (sum != expected) {
+        WSDB_FETAL(fmt::format("{}: sum {}, expected {}", scan.first, sum, expected));
+      }
+    }
+    Print(scan.first, rec_num, ns);
+  }
+}
+
+/**
+ * Full scans of a table read through the buffer pool and of the same rows in a table mapped into memory, both tables
+ * have more pages than the pool
+ */
+void BenchMmap()
+{
+  auto          rec_num = MappedTableRows();
+  BenchDatabase buffer_pool(PAGE_CHECKSUM, BENCH_POOL_SIZE / 4);
+  BenchDatabase mapped(PAGE_CHECKSUM, BENCH_POOL_SIZE / 4);
+  buffer_pool.Fill(rec_num);
+  mapped.Fill(rec_num);
+  mapped.MapTable();
+  if (!mapped.Reopen()->IsMapped()) {
+    WSDB_FETAL("mmap: the table is not mapped");
+  }
+  CompareScans({{"buffer_pool", &buffer_pool}, {"mapped", &mapped}}, rec_num);
+}
+
+/**
+ * SELECT g, SUM(v), MAX(f) FROM t GROUP BY g a row at a time, as a row-based aggregation does it: every row is copied
+ * into a Record, its group key into another one and the accumulators are Values updated through their operators
+ * @return the number of groups
+ */
+auto AggregateRows(TableHandle *table) -> size_t
+{
+  RecordSchema                                                group_schema({table->GetSchema().GetFieldAt(0)});
+  std::unordered_map<Record, std::pair<ValueSptr, ValueSptr>> groups;
+  SeqScanExecutor                                             scan(table);
+  for (scan.Init(); !scan.IsEnd(); scan.Next()) {
+    auto record         = scan.GetRecordView().ToRecord();
+    auto v              = record->GetValueAt(1);
+    auto f              = record->GetValueAt(2);
+    auto [it, inserted] = groups.try_emplace(Record(&group_schema, *record), v, f);
+    if (!inserted) {
+      *it->second.first += *v;
+      if (*f > *it->second.second) {
+        it->second.second = f;
+      }
+    }
+  }
+  return groups.size();
+}
+
+/**
+ * SELECT g, SUM(v), MAX(f) FROM t GROUP BY g with about BENCH_GROUP_NUM groups, by AggregateExecutorVec and a row at
+ * a time, on an N-ary and a PAX table with the same rows
+ */
+void BenchAggregate()
+{
+  constexpr size_t rec_num = BENCH_REC_NUM * 5;
+  BenchDatabase    nary;
+  BenchDatabase    pax(PAGE_CHECKSUM, BENCH_POOL_SIZE, BUFFER_POOL_SHARD_NUM, false, PAX_MODEL);
+  for (auto [model, db] : {std::make_pair("nary", &nary), std::make_pair("pax", &pax)}) {
+    db->Fill(rec_num);
+    const auto &schema = db->GetTable()->GetSchema();
+    auto        sum_v  = schema.GetFieldAt(1);
+    sum_v.is_agg_      = true;
+    sum_v.agg_type_    = AGG_SUM;
+    auto max_f         = schema.GetFieldAt(2);
+    max_f.is_agg_      = true;
+    max_f.agg_type_    = AGG_MAX;
+    AggregateExecutorVec agg(std::make_unique<SeqScanExecutor>(db->GetTable()),
+        std::make_unique<RecordSchema>(std::vector<RTField>{sum_v, max_f}),
+        std::make_unique<RecordSchema>(std::vector<RTField>{schema.GetFieldAt(0)}));
+    size_t vec_groups = 0;
+    Report(fmt::format("aggregate_vec/{}", model), rec_num, [&]() {
+      agg.InitBatch();
+      for (auto chunk = agg.NextBatch(EXECUTOR_BATCH_SIZE); chunk != nullptr;
+           chunk      = agg.NextBatch(EXECUTOR_BATCH_SIZE)) {
+        vec_groups += chunk->GetSize();
+      }
+    });
+    size_t row_groups = 0;
+    Report(fmt::format("aggregate_row/{}", model), rec_num, [&row_groups, db = db]() {
+      row_groups = AggregateRows(db->GetTable());
+    });
+    if (vec_groups == 0 || vec_groups > BENCH_GROUP_NUM || vec_groups != row_groups) {
+      WSDB_FETAL(fmt::format("aggregate: {} groups, {} a row at a time", vec_groups, row_groups));
+    }
+  }
+}
+
+}  // namespace
+}  // namespace wsdb
+
+int main(int argc, char *argv[])
+{
+  using namespace wsdb;
+  const std::vector<std::pair<std::string, std::function<void()>>> benchmarks{
+      {"replacer", BenchReplacers},
+      {"checksum", BenchChecksum},
+      {"async_read", BenchAsyncRead},
+      {"pool_size", BenchPoolSize},
+      {"threads", BenchThreads},
+      {"mixed", BenchMixed},
+      {"direct_io", BenchDirectIO},
+      {"mmap", BenchMmap},
+      {"scan_page", BenchScanPage},
+      {"pax", BenchPax},
+      {"bulk_insert", BenchBulkInsert},
+      {"scan", BenchScan},
+      {"aggregate", BenchAggregate},
+  };
+  std::vector<std::string> names(argv + 1, argv + argc);
+  for (const auto &name : names) {
+    auto found = std::find_if(benchmarks.begin(), benchmarks.end(), [&name](const auto &b) { return b.first == name; });
+    if (found == benchmarks.end()) {
+      fmt::print(stderr, "unknown benchmark {}\n", name);
+      return 1;
+    }
+  }
+  ScratchDirectory scratch;
+  for (const auto &[name, bench] : benchmarks) {
+    if (names.empty() || std::find(names.begin(), names.end(), name) != names.end()) {
+      bench();
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,101 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#ifndef WSDB_ARENA_H
+#define WSDB_ARENA_H
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include "config.h"
+#include "../../common/micro.h"
+
+namespace wsdb {
+
+/**
+ * Bump allocator for memory that is dropped all at once, e.g. the records of a page being scanned. Allocations are
+ * carved out of blocks that Reset keeps, so an arena that is reset between batches stops calling new once it has
+ * grown to the size of a batch. Nothing is constructed or destructed, it is meant for raw record memory
+ */
+class Arena
+{
+public:
+  explicit Arena(size_t block_size = ARENA_BLOCK_SIZE) : block_size_(block_size) {}
+
+  ~Arena() = default;
+
+  DISABLE_COPY_MOVE_AND_ASSIGN(Arena)
+
+  /**
+   * @param align a power of 2 no larger than alignof(std::max_align_t)
+   * @return size bytes valid until the next Reset
+   */
+  auto Allocate(size_t size, size_t align = alignof(std::max_align_t)) -> char *
+  {
+    for (; block_idx_ < blocks_.size(); ++block_idx_, offset_ = 0) {
+      auto start = (offset_ + align - 1) & ~(align - 1);
+      if (start + size <= blocks_[block_idx_].size_) {
+        offset_ = start + size;
+        return blocks_[block_idx_].data_.get() + start;
+      }
+    }
+    // blocks are aligned to max_align_t by new, a large request gets a block of its own
+    auto block_size = std::max(block_size_, size);
+    blocks_.push_back({std::make_unique<char[]>(block_size), block_size});
+    block_idx_ = blocks_.size() - 1;
+    offset_    = size;
+    return blocks_.back().data_.get();
+  }
+
+  /**
+   * Drop all allocations, the blocks are kept for the next ones
+   */
+  void Reset()
+  {
+    block_idx_ = 0;
+    offset_    = 0;
+  }
+
+  /**
+   * @return bytes held by the arena, allocated or not
+   */
+  [[nodiscard]] auto GetCapacity() const -> size_t
+  {
+    size_t capacity = 0;
+    for (const auto &block : blocks_) {
+      capacity += block.size_;
+    }
+    return capacity;
+  }
+
+private:
+  struct Block
+  {
+    std::unique_ptr<char[]> data_;
+    size_t                  size_;
+  };
+
+  size_t             block_size_;
+  std::vector<Block> blocks_;
+  size_t             block_idx_{0};  // block allocations are carved out of
+  size_t             offset_{0};     // first free byte of that block
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_ARENA_H
@@ -22,10 +22,16 @@
 #ifndef WSDB_BITMAP_H
 #define WSDB_BITMAP_H
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include "../../common/error.h"
 #include "../../common/micro.h"
 
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
 namespace wsdb {
 #define BITMAP_WIDTH 8
 #define BITMAP_SIZE(bit_num) ((bit_num + BITMAP_WIDTH - 1) / BITMAP_WIDTH)
@@ -56,15 +62,147 @@ public:
 
   static void Set(char *bitmap, size_t bit_num) { memset(bitmap, 0xff, BITMAP_SIZE(bit_num)); }
 
+  /**
+   * @return index of the first bit in [start, bit_num) that equals value, bit_num if there is none
+   */
   static auto FindFirst(const char *bitmap, size_t bit_num, size_t start, bool value) -> size_t
   {
-    for (size_t i = start; i < bit_num; i++) {
-      if (GetBit(bitmap, i) == value) {
-        return i;
+    if (start >= bit_num) {
+      return bit_num;
+    }
+    // search for set bits, looking for clear ones is the same search on the flipped words
+    uint64_t flip     = value ? 0 : ~uint64_t{0};
+    size_t   word_num = WordNum(bit_num);
+    size_t   word_idx = start / WORD_BITS;
+    uint64_t word     = (LoadWord(bitmap, bit_num, word_idx) ^ flip) & (~uint64_t{0} << (start % WORD_BITS));
+    while (word == 0) {
+      word_idx = SkipWords(bitmap, bit_num, word_idx + 1, value);
+      if (word_idx == word_num) {
+        return bit_num;
+      }
+      word = LoadWord(bitmap, bit_num, word_idx) ^ flip;
+    }
+    // the padding of the last word reads as 0 and flips to 1
+    return std::min(word_idx * WORD_BITS + __builtin_ctzll(word), bit_num);
+  }
+
+  /**
+   * @return number of set bits in [0, bit_num)
+   */
+  static auto CountSet(const char *bitmap, size_t bit_num) -> size_t
+  {
+    size_t count    = 0;
+    size_t word_num = WordNum(bit_num);
+    size_t word_idx = 0;
+#if defined(__x86_64__)
+    if (word_num >= AVX2_MIN_WORDS && HasAvx2()) {
+      word_idx = (bit_num / WORD_BITS) / AVX2_WORDS * AVX2_WORDS;
+      count    = CountSetAvx2(bitmap, word_idx / AVX2_WORDS);
+    }
+#endif
+    for (; word_idx < word_num; word_idx++) {
+      count += __builtin_popcountll(LoadWord(bitmap, bit_num, word_idx));
+    }
+    return count;
+  }
+
+  /**
+   * Call func with the index of every set bit in [0, bit_num) in ascending order, a word of the bitmap is loaded
+   * at a time so runs of clear bits are skipped 64 at once
+   */
+  template <typename Func>
+  static void ForEachSet(const char *bitmap, size_t bit_num, Func &&func)
+  {
+    size_t word_num = WordNum(bit_num);
+    for (size_t word_idx = 0; word_idx < word_num; word_idx++) {
+      for (uint64_t word = LoadWord(bitmap, bit_num, word_idx); word != 0; word &= word - 1) {
+        func(word_idx * WORD_BITS + __builtin_ctzll(word));
+      }
+    }
+  }
+
+private:
+  static constexpr size_t WORD_BITS = 64;
+  // bitmaps of at least this many words take the AVX2 paths, which handle 256 bits per step
+  static constexpr size_t AVX2_WORDS     = 4;
+  static constexpr size_t AVX2_MIN_WORDS = 2 * AVX2_WORDS;
+
+  static constexpr auto WordNum(size_t bit_num) -> size_t { return (bit_num + WORD_BITS - 1) / WORD_BITS; }
+
+  /**
+   * Load the word_idx-th 64 bits of the bitmap, bit i of the word is bit word_idx * 64 + i of the bitmap.
+   * Bytes beyond BITMAP_SIZE(bit_num) are not read and bits beyond bit_num read as 0
+   */
+  static auto LoadWord(const char *bitmap, size_t bit_num, size_t word_idx) -> uint64_t
+  {
+    uint64_t word  = 0;
+    size_t   begin = word_idx * sizeof(uint64_t);
+    memcpy(&word, bitmap + begin, std::min(sizeof(uint64_t), BITMAP_SIZE(bit_num) - begin));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    word = __builtin_bswap64(word);
+#endif
+    if ((word_idx + 1) * WORD_BITS > bit_num && bit_num % WORD_BITS != 0) {
+      word &= (uint64_t{1} << (bit_num % WORD_BITS)) - 1;
+    }
+    return word;
+  }
+
+  /**
+   * @return the first word from word_idx on that may hold a bit equal to value, whole words of the opposite value
+   * are skipped a block at a time on CPUs with AVX2, only full words are skipped
+   */
+  static auto SkipWords(const char *bitmap, size_t bit_num, size_t word_idx, bool value) -> size_t
+  {
+#if defined(__x86_64__)
+    size_t full_words = bit_num / WORD_BITS;
+    if (full_words >= word_idx + AVX2_MIN_WORDS && HasAvx2()) {
+      return SkipWordsAvx2(bitmap, word_idx, full_words, value);
+    }
+#endif
+    return word_idx;
+  }
+
+#if defined(__x86_64__)
+  static auto HasAvx2() -> bool
+  {
+    static const bool has_avx2 = __builtin_cpu_supports("avx2");
+    return has_avx2;
+  }
+
+  __attribute__((target("avx2"))) static auto SkipWordsAvx2(
+      const char *bitmap, size_t word_idx, size_t word_end, bool value) -> size_t
+  {
+    for (; word_idx + AVX2_WORDS <= word_end; word_idx += AVX2_WORDS) {
+      auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitmap + word_idx * sizeof(uint64_t)));
+      // testz: no bit set, testc: every bit set
+      bool skip = value ? _mm256_testz_si256(block, block) : _mm256_testc_si256(block, _mm256_set1_epi8(-1));
+      if (!skip) {
+        break;
       }
     }
-    return bit_num;
+    return word_idx;
+  }
+
+  /**
+   * Population count of block_num blocks of 256 bits, nibbles are counted with a shuffle lookup and the byte counts
+   * summed with sad
+   */
+  __attribute__((target("avx2"))) static auto CountSetAvx2(const char *bitmap, size_t block_num) -> size_t
+  {
+    const auto lookup = _mm256_setr_epi8(
+        0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const auto low_mask = _mm256_set1_epi8(0x0f);
+    auto       total    = _mm256_setzero_si256();
+    for (size_t i = 0; i < block_num; i++) {
+      auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(bitmap) + i);
+      auto low   = _mm256_shuffle_epi8(lookup, _mm256_and_si256(block, low_mask));
+      auto high  = _mm256_shuffle_epi8(lookup, _mm256_and_si256(_mm256_srli_epi16(block, 4), low_mask));
+      total      = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(low, high), _mm256_setzero_si256()));
+    }
+    return _mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) + _mm256_extract_epi64(total, 2) +
+           _mm256_extract_epi64(total, 3);
   }
+#endif
 };
 }  // namespace wsdb
 
@@ -24,13 +24,65 @@
 #include <string>
 /// storage
 constexpr size_t  PAGE_SIZE        = 4096;
+// stamp data pages with a CRC32C when they are written and verify it when they are read, overridden by
+// page_checksum in CONFIG_FILE or the WSDB_PAGE_CHECKSUM environment variable. Off by default, the scan benchmark
+// of wsdb_bench reports its overhead on scans that read from disk. Pages written without it are unstamped and
+// still pass verification once it is turned on
+constexpr bool    PAGE_CHECKSUM    = false;
+// default number of frames, overridden at startup by buffer_pool_size in CONFIG_FILE or
+// the WSDB_BUFFER_POOL_SIZE environment variable
 constexpr size_t  BUFFER_POOL_SIZE = 8;
+// back the frames with huge pages if possible, overridden by buffer_pool_huge_pages or
+// WSDB_BUFFER_POOL_HUGE_PAGES
+constexpr bool    BUFFER_POOL_HUGE_PAGES = false;
+// the pool is partitioned into shards with separate latches, overridden by buffer_pool_shards or
+// WSDB_BUFFER_POOL_SHARDS, small pools use fewer shards so that each has at least MIN_SHARD_SIZE frames
+constexpr size_t  BUFFER_POOL_SHARD_NUM      = 16;
+constexpr size_t  BUFFER_POOL_MIN_SHARD_SIZE = 64;
+// "LRUReplacer", "LRUKReplacer" or "ClockReplacer"
 const std::string REPLACER         = "LRUReplacer";
-// enable this to use LRUKReplacer
+// used by LRUKReplacer
 const size_t REPLACER_LRU_K = 10;
+// the background flusher of the buffer pool starts writing dirty pages when less than LOW of the frames are
+// clean and evictable, and stops when HIGH of them are
+constexpr double BUFFER_FLUSH_LOW_WATERMARK  = 0.1;
+constexpr double BUFFER_FLUSH_HIGH_WATERMARK = 0.25;
+constexpr size_t BUFFER_FLUSH_INTERVAL_MS    = 100;
+// large sequential scans and bulk inserts recycle a private ring of this many frames instead of flooding the
+// pool, a scan gets a ring once the table has more than 1 / BUFFER_RING_THRESHOLD of the pool's pages
+constexpr size_t BUFFER_RING_BULK_READ_SIZE  = 32;
+constexpr size_t BUFFER_RING_BULK_WRITE_SIZE = 512;
+constexpr size_t BUFFER_RING_THRESHOLD       = 4;
+// after READAHEAD_TRIGGER consecutive misses on a file the following pages are read asynchronously, the window
+// starts at READAHEAD_MIN pages and doubles up to READAHEAD_MAX as long as the access stays sequential
+constexpr size_t BUFFER_READAHEAD_TRIGGER = 2;
+constexpr size_t BUFFER_READAHEAD_MIN     = 8;
+constexpr size_t BUFFER_READAHEAD_MAX     = 64;
+// the background flusher logs the buffer pool statistics every STATS_LOG_INTERVAL_MS, 0 disables the log
+constexpr size_t BUFFER_STATS_LOG_INTERVAL_MS = 60000;
+// engine of DiskManager's asynchronous page I/O, "IOUringEngine" or "ThreadPoolIOEngine",
+// io_uring falls back to the worker pool when the kernel does not support it
+const std::string IO_ENGINE        = "IOUringEngine";
+constexpr size_t  IO_URING_ENTRIES = 256;
+constexpr size_t  IO_WORKER_NUM    = 4;
 /// system
 constexpr size_t MAX_REC_SIZE = 1024;
+// table pages bypass the OS page cache with O_DIRECT, overridden by table_direct_io in CONFIG_FILE or the
+// WSDB_TABLE_DIRECT_IO environment variable
+constexpr bool   TABLE_DIRECT_IO    = false;
+// same for index pages, overridden by index_direct_io or WSDB_INDEX_DIRECT_IO. Sort runs are spilled through
+// std::fstream rather than DiskManager, so they always go through the page cache
+constexpr bool   INDEX_DIRECT_IO    = false;
+// tables listed in mmap_tables in CONFIG_FILE or the WSDB_MMAP_TABLES environment variable, e.g. "t1,t2", are
+// opened read-only and scanned from a memory mapping of the file instead of through the buffer pool
+const std::string MMAP_TABLES        = "";
+// table files grow by extents of at least this many pages, preallocated in one call instead of page by page
+constexpr size_t TABLE_EXTENT_PAGES = 64;
 /// executor
+// max number of rows in a chunk of the batch interface of the executors
+constexpr size_t EXECUTOR_BATCH_SIZE = 1024;
+// records that live for a page or a row of an executor are carved out of arena blocks of this size
+constexpr size_t ARENA_BLOCK_SIZE = 64 * 1024;
 // 64MB, used for sort executor's buffer
 constexpr size_t SORT_BUFFER_SIZE = 64 * 1024 * 1024;
 // 10-way merge sort, max tmp file to use in merge sort
@@ -39,6 +91,7 @@ constexpr size_t SORT_WAY_NUM = 10;
 const std::string DB_SUFFIX  = ".db";
 const std::string TAB_SUFFIX = ".tab";
 const std::string IDX_SUFFIX = ".idx";
+const std::string FSM_SUFFIX = ".fsm";
 const std::string TMP_SUFFIX = ".tmp";
 
 const std::string DB_DIR  = "db";
@@ -46,6 +99,9 @@ const std::string TAB_DIR = "tab";
 const std::string IDX_DIR = "idx";
 const std::string TMP_DIR = ".tmp";
 
+// optional "key = value" settings read from DATA_DIR at startup
+const std::string CONFIG_FILE = "wsdb.conf";
+
 // Working directory will be written by cmake
 const std::string DATA_DIR = "./data";
 
@@ -80,19 +80,25 @@ struct RTField
   }
 };
 
+// the table header on disk starts with the magic and the version, a table whose header lacks them or has another
+// version is refused when it is opened
+constexpr uint32_t TABLE_HEADER_MAGIC   = 0x42445357;  // "WSDB"
+constexpr uint32_t TABLE_HEADER_VERSION = 1;
+
 /**
  * Table header is the first page of a table, it contains the meta information of the table
  */
 struct TableHeader
 {
-  size_t    page_num_{0};
-  page_id_t first_free_page_{INVALID_PAGE_ID};
+  size_t    page_num_{0};  // pages in use, including the file header page
+  page_id_t first_free_page_{INVALID_PAGE_ID};  // unused, pages with room are tracked by the FreeSpaceMap
   size_t    rec_num_{0};
   size_t    rec_size_{0};
   size_t    rec_per_page_{0};
   size_t    field_num_{0};
   size_t    bitmap_size_{0};   // bit map size == BITMAP_SIZE(n_rec_per_page)
   size_t    nullmap_size_{0};  // null map size == BITMAP_SIZE(n_field)
+  size_t allocated_page_num_{0};  // pages the file has space for, the ones beyond page_num_ are preallocated
 };
 
 #endif  // WSDB_META_H
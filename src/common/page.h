@@ -32,7 +32,10 @@
 #define PAGE_LSN_OFFSET 0
 #define PAGE_NEXT_FREE_PAGE_ID_OFFSET (PAGE_LSN_OFFSET + sizeof(lsn_t))
 #define PAGE_RECORD_NUM_OFFSET (PAGE_NEXT_FREE_PAGE_ID_OFFSET + sizeof(page_id_t))
-#define PAGE_HEADER_SIZE (PAGE_RECORD_NUM_OFFSET + sizeof(size_t))
+// CRC32C of the page stamped by DiskManager on write, 0 if the page was never stamped. The page layout is versioned by
+// TABLE_HEADER_VERSION, tables with pages of the older 16-byte header are refused when they are opened
+#define PAGE_CHECKSUM_OFFSET (PAGE_RECORD_NUM_OFFSET + sizeof(size_t))
+#define PAGE_HEADER_SIZE (PAGE_CHECKSUM_OFFSET + sizeof(uint32_t))
 
 class Page
 {
@@ -52,6 +55,11 @@ public:
 
  auto GetData() -> char * { return data_; }
 
+ /**
+  * Bind the page to its data buffer of PAGE_SIZE bytes, the buffer is owned by the buffer pool
+  */
+ void SetData(char *data) { data_ = data; }
+
  auto GetLsn() -> lsn_t
  {
    WSDB_ASSERT(pid_ != FILE_HEADER_PAGE_ID, "Can't load data from file header page");
@@ -92,13 +100,15 @@ public:
  {
    fid_ = INVALID_FILE_ID;
    pid_ = INVALID_PAGE_ID;
-   memset(data_, 0, PAGE_SIZE);
+   if (data_ != nullptr) {
+     memset(data_, 0, PAGE_SIZE);
+   }
  }
 
 private:
  file_id_t fid_{INVALID_FILE_ID};
  page_id_t pid_{INVALID_PAGE_ID};
- char      data_[PAGE_SIZE]{};
+ char     *data_{nullptr};
 };
 
 #endif  // WSDB_PAGE_H
\ No newline at end of file
@@ -64,10 +64,7 @@ auto Executor::Translate(const std::shared_ptr<AbstractPlan> &plan, DatabaseHand
     }
     return std::make_unique<DeleteExecutor>(Translate(del->child_, db), tab, db->GetIndexes(del->table_name_));
   } else if (const auto filter = std::dynamic_pointer_cast<FilterPlan>(plan)) {
-    std::function<bool(const Record &)> filter_func = [filter](const Record &record) {
-      return ConditionExpr::Eval(filter->conds_, record);
-    };
-    return std::make_unique<FilterExecutor>(Translate(filter->child_, db), std::move(filter_func));
+    return std::make_unique<FilterExecutor>(Translate(filter->child_, db), filter->conds_);
   } else if (const auto scan = std::dynamic_pointer_cast<ScanPlan>(plan)) {
     auto tab = db->GetTable(scan->table_name_);
     if (tab == nullptr) {
@@ -98,8 +95,12 @@ auto Executor::Translate(const std::shared_ptr<AbstractPlan> &plan, DatabaseHand
   } else if (const auto agg_plan = std::dynamic_pointer_cast<AggregatePlan>(plan)) {
     auto agg_schema   = std::make_unique<RecordSchema>(agg_plan->agg_fields);
     auto group_schema = std::make_unique<RecordSchema>(agg_plan->group_fields_);
-    return std::make_unique<AggregateExecutor>(
-        Translate(agg_plan->child_, db), std::move(agg_schema), std::move(group_schema));
+    auto child        = Translate(agg_plan->child_, db);
+    // aggregate column-wise when the child produces chunks natively
+    if (child->SupportsBatch()) {
+      return std::make_unique<AggregateExecutorVec>(std::move(child), std::move(agg_schema), std::move(group_schema));
+    }
+    return std::make_unique<AggregateExecutor>(std::move(child), std::move(agg_schema), std::move(group_schema));
   } else if (const auto lim = std::dynamic_pointer_cast<LimitPlan>(plan)) {
     return std::make_unique<LimitExecutor>(Translate(lim->child_, db), lim->limit_);
 
@@ -131,13 +132,23 @@ void Executor::Execute(const AbstractExecutorUptr &executor, Context *ctx)
       ctx->nt_ctl_->SendRec(ctx->client_fd_, rec.get());
     }
     ctx->nt_ctl_->SendRecFinish(ctx->client_fd_);
+  } else if (executor->SupportsBatch()) {
+    // the plan produces chunks all the way down, send them without going through records
+    auto header = executor->GetOutSchema();
+    ctx->nt_ctl_->SendRecHeader(ctx->client_fd_, header);
+    executor->InitBatch();
+    for (auto chunk = executor->NextBatch(EXECUTOR_BATCH_SIZE); chunk != nullptr;
+         chunk = executor->NextBatch(EXECUTOR_BATCH_SIZE)) {
+      ctx->nt_ctl_->SendChunk(ctx->client_fd_, chunk.get());
+    }
+    ctx->nt_ctl_->SendRecFinish(ctx->client_fd_);
   } else {
     auto header = executor->GetOutSchema();
     ctx->nt_ctl_->SendRecHeader(ctx->client_fd_, header);
     for (executor->Init(); !executor->IsEnd(); executor->Next()) {
-      auto rec = executor->GetRecord();
-      WSDB_ASSERT(rec != nullptr, "");
-      ctx->nt_ctl_->SendRec(ctx->client_fd_, rec.get());
+      auto rec = executor->GetRecordView();
+      WSDB_ASSERT(rec.IsValid(), "");
+      ctx->nt_ctl_->SendRec(ctx->client_fd_, rec);
     }
     ctx->nt_ctl_->SendRecFinish(ctx->client_fd_);
   }
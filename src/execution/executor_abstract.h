@@ -24,6 +24,7 @@
 
 #include "../../common/error.h"
 #include "../../common/micro.h"
+#include "common/config.h"
 #include "system/handle/record_handle.h"
 
 namespace wsdb {
@@ -63,14 +64,60 @@ public:
 
   [[nodiscard]] auto GetType() const -> ExecutorType { return type_; }
 
+  /**
+   * @return a copy of the current record, nullptr at the end
+   */
   [[nodiscard]] auto GetRecord() -> RecordUptr
   {
-    if (record_ == nullptr) {
+    auto view = GetRecordView();
+    if (!view.IsValid()) {
       return nullptr;
     }
-    return std::make_unique<Record>(*record_);
+    return view.ToRecord();
   };
 
+  /**
+   * The current record without copying it, invalid at the end. The view is valid until the next call of Init or Next,
+   * executors that pass the rows of their child along or keep them in an arena return views of those instead of
+   * setting record_
+   */
+  [[nodiscard]] virtual auto GetRecordView() const -> RecordView
+  {
+    return record_ == nullptr ? RecordView() : RecordView(*record_);
+  }
+
+  /**
+   * Prepare for NextBatch instead of the row interface. The default is Init, executors with a native batch path
+   * override it so that they do not position on their first record
+   */
+  virtual void InitBatch() { Init(); }
+
+  /**
+   * Batch interface, an alternative to Next/IsEnd/GetRecord for the consumers that work on chunks. InitBatch is
+   * called first, after which the executor is drained by NextBatch alone, the two interfaces are not mixed.
+   *
+   * Executors that produce chunks natively override it, for the others it gathers up to max_rows records of the row
+   * interface into a chunk.
+   * @return a chunk of the out schema with 1 to max_rows rows, nullptr once the executor is exhausted
+   */
+  virtual auto NextBatch(size_t max_rows) -> ChunkUptr
+  {
+    std::vector<RecordUptr> records;
+    for (; !IsEnd() && records.size() < max_rows; Next()) {
+      records.push_back(GetRecord());
+    }
+    if (records.empty()) {
+      return nullptr;
+    }
+    return Chunk::FromRecords(GetOutSchema(), records);
+  }
+
+  /**
+   * @return true if NextBatch produces chunks without going through the row interface of this executor or of the
+   * executors below it, a hint for the planner to pick vectorized operators on top of it
+   */
+  [[nodiscard]] virtual auto SupportsBatch() const -> bool { return false; }
+
 protected:
   RecordSchemaUptr out_schema_;
   RecordUptr       record_;
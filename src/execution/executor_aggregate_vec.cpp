@@ -20,5 +20,425 @@
 //
 
 #include "executor_aggregate_vec.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
 
-namespace wsdb {}  // namespace wsdb
\ No newline at end of file
+namespace wsdb {
+
+namespace {
+
+constexpr uint32_t INVALID_GROUP = std::numeric_limits<uint32_t>::max();
+constexpr size_t   INITIAL_SLOTS = 1024;
+constexpr uint64_t HASH_SEED     = 0x9E3779B97F4A7C15ULL;
+constexpr uint64_t NULL_HASH     = 0x2545F4914F6CDD1DULL;
+
+// finalizer of MurmurHash3, spreads the bits of h over all bits of the result
+inline auto Mix(uint64_t h) -> uint64_t
+{
+  h ^= h >> 33;
+  h *= 0xFF51AFD7ED558CCDULL;
+  h ^= h >> 33;
+  h *= 0xC4CEB9FE1A85EC53ULL;
+  h ^= h >> 33;
+  return h;
+}
+
+inline auto HashBytes(const char *data, size_t size) -> uint64_t
+{
+  uint64_t h = size;
+  for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    h = Mix(h ^ word);
+  }
+  if (size > 0) {
+    uint64_t word = 0;
+    memcpy(&word, data, size);
+    h = Mix(h ^ word);
+  }
+  return h;
+}
+
+// combine the values of a column into the hashes of the rows and copy them into the keys, 4-byte int and float
+// columns hash their values directly
+void HashColumn32(const ColumnVector &col, const std::vector<uint32_t> &rows, uint64_t *hashes, char *keys,
+    char *null_flags, size_t key_width)
+{
+  const auto *values = col.GetData<uint32_t>();
+  for (size_t r = 0; r < rows.size(); ++r) {
+    if (col.IsNull(rows[r])) {
+      null_flags[r * key_width] = 1;
+      hashes[r]                 = Mix(hashes[r] ^ NULL_HASH);
+      continue;
+    }
+    memcpy(keys + r * key_width, values + rows[r], sizeof(uint32_t));
+    hashes[r] = Mix(hashes[r] ^ values[rows[r]]);
+  }
+}
+
+void HashColumn(const ColumnVector &col, const std::vector<uint32_t> &rows, uint64_t *hashes, char *keys,
+    char *null_flags, size_t key_width)
+{
+  const char *data  = col.GetRawData();
+  auto        width = col.GetWidth();
+  for (size_t r = 0; r < rows.size(); ++r) {
+    if (col.IsNull(rows[r])) {
+      null_flags[r * key_width] = 1;
+      hashes[r]                 = Mix(hashes[r] ^ NULL_HASH);
+      continue;
+    }
+    const char *value = data + rows[r] * width;
+    memcpy(keys + r * key_width, value, width);
+    hashes[r] = Mix(hashes[r] ^ HashBytes(value, width));
+  }
+}
+
+template <typename T, typename S>
+void UpdateSum(const ColumnVector &col, const std::vector<uint32_t> &rows, const uint32_t *groups, int64_t *count,
+    S *sum)
+{
+  const T *values = col.GetData<T>();
+  for (size_t r = 0; r < rows.size(); ++r) {
+    if (!col.IsNull(rows[r])) {
+      sum[groups[r]] += values[rows[r]];
+      count[groups[r]]++;
+    }
+  }
+}
+
+// keep in extreme the value of each group for which cmp(value, extreme) is false for all the others
+template <typename T, typename Cmp>
+void UpdateExtreme(const ColumnVector &col, const std::vector<uint32_t> &rows, const uint32_t *groups,
+    int64_t *count, T *extreme, Cmp cmp)
+{
+  const T *values = col.GetData<T>();
+  for (size_t r = 0; r < rows.size(); ++r) {
+    if (col.IsNull(rows[r])) {
+      continue;
+    }
+    auto g = groups[r];
+    if (count[g]++ == 0 || cmp(values[rows[r]], extreme[g])) {
+      extreme[g] = values[rows[r]];
+    }
+  }
+}
+
+// strings are '\0' padded, so that comparing the whole width orders them as strcmp does
+void UpdateExtremeBytes(const ColumnVector &col, const std::vector<uint32_t> &rows, const uint32_t *groups,
+    int64_t *count, char *extreme, bool is_min)
+{
+  const char *data  = col.GetRawData();
+  auto        width = col.GetWidth();
+  for (size_t r = 0; r < rows.size(); ++r) {
+    if (col.IsNull(rows[r])) {
+      continue;
+    }
+    auto        g     = groups[r];
+    const char *value = data + rows[r] * width;
+    int         cmp   = count[g]++ == 0 ? 0 : memcmp(value, extreme + g * width, width);
+    if (count[g] == 1 || (is_min ? cmp < 0 : cmp > 0)) {
+      memcpy(extreme + g * width, value, width);
+    }
+  }
+}
+
+}  // namespace
+
+AggregateExecutorVec::AggregateExecutorVec(
+    AbstractExecutorUptr child, RecordSchemaUptr agg_schema, RecordSchemaUptr group_schema)
+    : AbstractExecutor(Basic),
+      child_(std::move(child)),
+      agg_schema_(std::move(agg_schema)),
+      group_schema_(std::move(group_schema))
+{
+  std::vector<RTField> fields;
+  for (const auto &field : group_schema_->GetFields()) {
+    fields.push_back(field);
+  }
+  for (const auto &field : agg_schema_->GetFields()) {
+    fields.push_back(field);
+  }
+  out_schema_ = std::make_unique<RecordSchema>(fields);
+
+  const auto *child_schema = child_->GetOutSchema();
+  auto        find_field   = [child_schema](const FieldSchema &field) {
+    auto idx = child_schema->GetFieldIndex(field.table_id_, field.field_name_);
+    if (idx == child_schema->GetFieldCount()) {
+      WSDB_THROW(WSDB_FIELD_MISS, field.field_name_);
+    }
+    return idx;
+  };
+  for (const auto &field : group_schema_->GetFields()) {
+    group_cols_.push_back(find_field(field.field_));
+    key_offsets_.push_back(key_width_);
+    key_width_ += child_schema->GetFieldAt(group_cols_.back()).field_.field_size_;
+  }
+  key_width_ += group_cols_.size();
+
+  for (const auto &field : agg_schema_->GetFields()) {
+    Accumulator acc{};
+    acc.type_ = field.agg_type_;
+    if (acc.type_ != AGG_COUNT_STAR) {
+      acc.col_          = find_field(field.field_);
+      const auto &input = child_schema->GetFieldAt(acc.col_).field_;
+      acc.in_type_      = input.field_type_;
+      acc.width_        = input.field_size_;
+    }
+    bool numeric = acc.in_type_ == TYPE_INT || acc.in_type_ == TYPE_FLOAT;
+    if ((acc.type_ == AGG_SUM || acc.type_ == AGG_AVG) && !numeric) {
+      WSDB_THROW(WSDB_TYPE_MISSMATCH,
+          fmt::format("{} of {} field {}", AggTypeToString(acc.type_), FieldTypeToString(acc.in_type_),
+              field.field_.field_name_));
+    }
+    accs_.push_back(std::move(acc));
+  }
+}
+
+void AggregateExecutorVec::Init()
+{
+  child_->InitBatch();
+  Build();
+  result_offset_ = 0;
+  record_        = result_->GetSize() > 0 ? result_->GetRecord(0) : nullptr;
+}
+
+void AggregateExecutorVec::Next()
+{
+  if (record_ == nullptr) {
+    return;
+  }
+  record_ = ++result_offset_ < result_->GetSize() ? result_->GetRecord(result_offset_) : nullptr;
+}
+
+auto AggregateExecutorVec::IsEnd() const -> bool { return record_ == nullptr; }
+
+void AggregateExecutorVec::InitBatch()
+{
+  child_->InitBatch();
+  Build();
+  result_offset_ = 0;
+  record_        = nullptr;
+}
+
+auto AggregateExecutorVec::NextBatch(size_t max_rows) -> ChunkUptr
+{
+  if (result_ == nullptr || result_offset_ >= result_->GetSize()) {
+    return nullptr;
+  }
+  auto count = std::min(max_rows, result_->GetSize() - result_offset_);
+  if (count == result_->GetSize()) {
+    return std::move(result_);
+  }
+  auto chunk = result_->Slice(result_offset_, count);
+  result_offset_ += count;
+  return chunk;
+}
+
+void AggregateExecutorVec::Build()
+{
+  slots_.assign(INITIAL_SLOTS, INVALID_GROUP);
+  keys_.clear();
+  hashes_.clear();
+  group_num_ = 0;
+  for (auto &acc : accs_) {
+    acc.count_.clear();
+    acc.int_sum_.clear();
+    acc.float_sum_.clear();
+    acc.extreme_.clear();
+  }
+
+  std::vector<uint32_t> rows;
+  for (auto chunk = child_->NextBatch(EXECUTOR_BATCH_SIZE); chunk != nullptr;
+       chunk = child_->NextBatch(EXECUTOR_BATCH_SIZE)) {
+    rows.resize(chunk->GetSize());
+    for (size_t r = 0; r < rows.size(); ++r) {
+      rows[r] = static_cast<uint32_t>(chunk->GetRowIndex(r));
+    }
+    FindGroups(*chunk, rows);
+    for (auto &acc : accs_) {
+      Update(acc, *chunk, rows);
+    }
+  }
+  if (group_cols_.empty() && group_num_ == 0) {
+    AddGroup(nullptr, HASH_SEED);
+  }
+  result_ = MakeResult();
+}
+
+void AggregateExecutorVec::FindGroups(const Chunk &chunk, const std::vector<uint32_t> &rows)
+{
+  auto n = rows.size();
+  row_hashes_.assign(n, HASH_SEED);
+  row_keys_.assign(n * key_width_, 0);
+  auto *null_flags = row_keys_.data() + key_width_ - group_cols_.size();
+  for (size_t i = 0; i < group_cols_.size(); ++i) {
+    const auto &col  = chunk.GetCol(group_cols_[i]);
+    auto       *keys = row_keys_.data() + key_offsets_[i];
+    if (col.GetWidth() == sizeof(uint32_t)) {
+      HashColumn32(col, rows, row_hashes_.data(), keys, null_flags + i, key_width_);
+    } else {
+      HashColumn(col, rows, row_hashes_.data(), keys, null_flags + i, key_width_);
+    }
+  }
+  row_groups_.resize(n);
+  for (size_t r = 0; r < n; ++r) {
+    row_groups_[r] = FindOrAddGroup(row_keys_.data() + r * key_width_, row_hashes_[r]);
+  }
+}
+
+auto AggregateExecutorVec::FindOrAddGroup(const char *key, uint64_t hash) -> uint32_t
+{
+  // keep the load factor under 1/2 so that probe sequences stay short
+  if ((group_num_ + 1) * 2 > slots_.size()) {
+    Grow();
+  }
+  auto mask = slots_.size() - 1;
+  for (auto pos = hash & mask;; pos = (pos + 1) & mask) {
+    auto group = slots_[pos];
+    if (group == INVALID_GROUP) {
+      slots_[pos] = static_cast<uint32_t>(group_num_);
+      AddGroup(key, hash);
+      return slots_[pos];
+    }
+    // without group fields the keys are empty and may be null
+    if (hashes_[group] == hash &&
+        (key_width_ == 0 || memcmp(keys_.data() + group * key_width_, key, key_width_) == 0)) {
+      return group;
+    }
+  }
+}
+
+void AggregateExecutorVec::AddGroup(const char *key, uint64_t hash)
+{
+  keys_.insert(keys_.end(), key, key + key_width_);
+  hashes_.push_back(hash);
+  group_num_++;
+  for (auto &acc : accs_) {
+    acc.count_.push_back(0);
+    if (acc.type_ == AGG_SUM || acc.type_ == AGG_AVG) {
+      acc.int_sum_.push_back(0);
+      acc.float_sum_.push_back(0);
+    } else if (acc.type_ == AGG_MIN || acc.type_ == AGG_MAX) {
+      acc.extreme_.resize(group_num_ * acc.width_);
+    }
+  }
+}
+
+void AggregateExecutorVec::Grow()
+{
+  slots_.assign(slots_.size() * 2, INVALID_GROUP);
+  auto mask = slots_.size() - 1;
+  for (uint32_t group = 0; group < group_num_; ++group) {
+    auto pos = hashes_[group] & mask;
+    while (slots_[pos] != INVALID_GROUP) {
+      pos = (pos + 1) & mask;
+    }
+    slots_[pos] = group;
+  }
+}
+
+void AggregateExecutorVec::Update(Accumulator &acc, const Chunk &chunk, const std::vector<uint32_t> &rows)
+{
+  const auto *groups = row_groups_.data();
+  auto       *count  = acc.count_.data();
+  if (acc.type_ == AGG_COUNT_STAR) {
+    for (size_t r = 0; r < rows.size(); ++r) {
+      count[groups[r]]++;
+    }
+    return;
+  }
+  const auto &col = chunk.GetCol(acc.col_);
+  switch (acc.type_) {
+    case AGG_COUNT:
+      for (size_t r = 0; r < rows.size(); ++r) {
+        count[groups[r]] += col.IsNull(rows[r]) ? 0 : 1;
+      }
+      break;
+    case AGG_SUM:
+    case AGG_AVG:
+      if (acc.in_type_ == TYPE_INT) {
+        UpdateSum<int32_t>(col, rows, groups, count, acc.int_sum_.data());
+      } else {
+        UpdateSum<float>(col, rows, groups, count, acc.float_sum_.data());
+      }
+      break;
+    case AGG_MIN:
+    case AGG_MAX: {
+      bool is_min = acc.type_ == AGG_MIN;
+      if (acc.in_type_ == TYPE_INT) {
+        auto *extreme = reinterpret_cast<int32_t *>(acc.extreme_.data());
+        if (is_min) {
+          UpdateExtreme(col, rows, groups, count, extreme, std::less<>());
+        } else {
+          UpdateExtreme(col, rows, groups, count, extreme, std::greater<>());
+        }
+      } else if (acc.in_type_ == TYPE_FLOAT) {
+        auto *extreme = reinterpret_cast<float *>(acc.extreme_.data());
+        if (is_min) {
+          UpdateExtreme(col, rows, groups, count, extreme, std::less<>());
+        } else {
+          UpdateExtreme(col, rows, groups, count, extreme, std::greater<>());
+        }
+      } else {
+        UpdateExtremeBytes(col, rows, groups, count, acc.extreme_.data(), is_min);
+      }
+      break;
+    }
+    default: WSDB_FETAL(fmt::format("unknown aggregate {}", AggTypeToString(acc.type_)));
+  }
+}
+
+auto AggregateExecutorVec::MakeResult() const -> ChunkUptr
+{
+  std::vector<ColumnVector> cols;
+  cols.reserve(out_schema_->GetFieldCount());
+  const auto *null_flags = keys_.data() + key_width_ - group_cols_.size();
+  for (size_t i = 0; i < group_cols_.size(); ++i) {
+    const auto  &field = out_schema_->GetFieldAt(i).field_;
+    ColumnVector col(field.field_type_, field.field_size_, group_num_);
+    for (size_t g = 0; g < group_num_; ++g) {
+      bool is_null = null_flags[g * key_width_ + i] != 0;
+      col.SetNull(g, is_null);
+      memcpy(col.GetMutableRawData() + g * field.field_size_, keys_.data() + g * key_width_ + key_offsets_[i],
+          field.field_size_);
+    }
+    col.SetSize(group_num_);
+    cols.push_back(std::move(col));
+  }
+  for (size_t j = 0; j < accs_.size(); ++j) {
+    const auto  &acc   = accs_[j];
+    const auto  &field = out_schema_->GetFieldAt(group_cols_.size() + j).field_;
+    ColumnVector col(field.field_type_, field.field_size_, group_num_);
+    auto        *data = col.GetMutableRawData();
+    for (size_t g = 0; g < group_num_; ++g) {
+      auto count = acc.count_[g];
+      if (acc.type_ == AGG_COUNT || acc.type_ == AGG_COUNT_STAR) {
+        auto value = static_cast<int32_t>(count);
+        memcpy(data + g * sizeof(value), &value, sizeof(value));
+        col.SetNull(g, false);
+        continue;
+      }
+      col.SetNull(g, count == 0);
+      if (count == 0) {
+        continue;
+      }
+      if (acc.type_ == AGG_MIN || acc.type_ == AGG_MAX) {
+        memcpy(data + g * acc.width_, acc.extreme_.data() + g * acc.width_, acc.width_);
+      } else if (acc.in_type_ == TYPE_INT) {
+        auto sum   = acc.int_sum_[g];
+        auto value = static_cast<int32_t>(acc.type_ == AGG_SUM ? sum : sum / count);
+        memcpy(data + g * sizeof(value), &value, sizeof(value));
+      } else {
+        auto sum   = acc.float_sum_[g];
+        auto value = static_cast<float>(acc.type_ == AGG_SUM ? sum : sum / static_cast<double>(count));
+        memcpy(data + g * sizeof(value), &value, sizeof(value));
+      }
+    }
+    col.SetSize(group_num_);
+    cols.push_back(std::move(col));
+  }
+  return std::make_unique<Chunk>(out_schema_.get(), std::move(cols));
+}
+
+}  // namespace wsdb
\ No newline at end of file
@@ -25,8 +25,94 @@
 
 namespace wsdb {
 
+/**
+ * Hash aggregation over the chunks of the child. A chunk is processed a column at a time: the group fields are hashed
+ * and packed into fixed-width keys, the keys are looked up in an open-addressing table that maps them to group ids,
+ * then each accumulator is updated by a typed loop over its input column and the group ids.
+ *
+ * The out schema is the group fields followed by the aggregate fields. Rows with null group fields form their own
+ * group. COUNT(*) counts rows and COUNT non-null inputs, both are ints. SUM, AVG, MIN and MAX skip nulls and are null
+ * for a group without any non-null input. SUM and AVG have the type of their field, so the AVG of an int field is an
+ * int, the sum divided by the count truncated toward zero, and they throw WSDB_TYPE_MISSMATCH for other fields.
+ * Without group fields there is exactly one group, even for an empty input, whose counts are 0 and other aggregates
+ * null. With group fields an empty input has no group
+ */
 class AggregateExecutorVec : public AbstractExecutor
-{};
+{
+public:
+  AggregateExecutorVec(AbstractExecutorUptr child, RecordSchemaUptr agg_schema, RecordSchemaUptr group_schema);
+
+  void Init() override;
+
+  void Next() override;
+
+  [[nodiscard]] auto IsEnd() const -> bool override;
+
+  void InitBatch() override;
+
+  auto NextBatch(size_t max_rows) -> ChunkUptr override;
+
+  [[nodiscard]] auto SupportsBatch() const -> bool override { return child_->SupportsBatch(); }
+
+private:
+  struct Accumulator
+  {
+    AggType              type_;
+    FieldType            in_type_;
+    size_t               col_;    // index of the input in the child schema, unused by COUNT(*)
+    size_t               width_;  // width of the input
+    std::vector<int64_t> count_;  // number of non-null inputs of each group
+    std::vector<int64_t> int_sum_;
+    std::vector<double>  float_sum_;
+    std::vector<char>    extreme_;  // MIN or MAX of each group, width_ bytes each
+  };
+
+  /**
+   * Drain the child into the hash table and build result_
+   */
+  void Build();
+
+  /**
+   * Hash and pack the keys of the rows of the chunk and find their group ids in row_groups_, creating missing groups
+   * @param rows indexes of the rows in the columns of the chunk
+   */
+  void FindGroups(const Chunk &chunk, const std::vector<uint32_t> &rows);
+
+  auto FindOrAddGroup(const char *key, uint64_t hash) -> uint32_t;
+
+  void AddGroup(const char *key, uint64_t hash);
+
+  void Grow();
+
+  void Update(Accumulator &acc, const Chunk &chunk, const std::vector<uint32_t> &rows);
+
+  auto MakeResult() const -> ChunkUptr;
+
+private:
+  AbstractExecutorUptr     child_;
+  RecordSchemaUptr         agg_schema_;
+  RecordSchemaUptr         group_schema_;
+  std::vector<size_t>      group_cols_;  // index of each group field in the child schema
+  std::vector<size_t>      key_offsets_;
+  // a key holds the values of the group fields followed by a null flag byte per field, null values are zeroed
+  size_t                   key_width_{0};
+  std::vector<Accumulator> accs_;
+
+  // open addressing with linear probing, a slot holds a group id or INVALID_GROUP
+  std::vector<uint32_t> slots_;
+  std::vector<char>     keys_;    // key of each group
+  std::vector<uint64_t> hashes_;  // hash of each group
+  size_t                group_num_{0};
+
+  // scratch space of the chunk being aggregated
+  std::vector<uint64_t> row_hashes_;
+  std::vector<char>     row_keys_;
+  std::vector<uint32_t> row_groups_;
+
+  // one row per group, handed out by NextBatch or a record at a time
+  ChunkUptr result_;
+  size_t    result_offset_{0};
+};
 
 }  // namespace wsdb
 
@@ -23,6 +23,7 @@
 #define WSDB_EXECUTOR_DEFS_H
 
 #include "executor_aggregate.h"
+#include "executor_aggregate_vec.h"
 #include "executor_ddl.h"
 #include "executor_delete.h"
 #include "executor_filter.h"
@@ -20,24 +20,32 @@
 //
 
 #include "executor_filter.h"
+#include "expr/condition_expr.h"
 
 namespace wsdb {
 
-FilterExecutor::FilterExecutor(AbstractExecutorUptr child, std::function<bool(const Record &)> filter)
+FilterExecutor::FilterExecutor(AbstractExecutorUptr child, std::function<bool(const RecordView &)> filter)
     : AbstractExecutor(Basic), child_(std::move(child)), filter_(std::move(filter))
 {}
+
+FilterExecutor::FilterExecutor(AbstractExecutorUptr child, ConditionVec conds)
+    : AbstractExecutor(Basic), child_(std::move(child)), conds_(std::move(conds)), has_conds_(true)
+{}
+
+auto FilterExecutor::Pass(const RecordView &record) const -> bool
+{
+  return has_conds_ ? ConditionExpr::Eval(conds_, record) : filter_(record);
+}
 void FilterExecutor::Init()
 {
   //WSDB_STUDENT_TODO(l2, t1);
   child_->Init();
-  record_ = nullptr;
 
+  // the current record is the one the child is positioned on, it is not copied
   for (; !child_->IsEnd(); child_->Next())
   {
-    auto current_record = child_->GetRecord();
-    if (current_record && filter_(*current_record))
+    if (Pass(child_->GetRecordView()))
     {
-      record_ = child_->GetRecord();
       break;
     }
   }
@@ -46,25 +54,50 @@ void FilterExecutor::Init()
 void FilterExecutor::Next()
 {
   //WSDB_STUDENT_TODO(l2, t1);
+  if (child_->IsEnd()) return;
+
   for (child_->Next(); !child_->IsEnd(); child_->Next())
   {
-    auto current_record = child_->GetRecord();
-    if (current_record && filter_(*current_record))
+    if (Pass(child_->GetRecordView()))
     {
-      // 如果找到符合过滤条件的记录，保存并退出函数
-      record_ = child_->GetRecord();
+      // 如果找到符合过滤条件的记录，退出函数
       return;
     }
   }
-
-  // 如果没有符合条件的记录，设置记录为空
-  record_ = nullptr;
+  // 如果没有符合条件的记录，child 已到末尾
 }
 
 auto FilterExecutor::IsEnd() const -> bool
 {
   //WSDB_STUDENT_TODO(l2, t1);
-  return record_ == nullptr;
+  return child_->IsEnd();
+}
+
+auto FilterExecutor::GetRecordView() const -> RecordView { return child_->GetRecordView(); }
+
+void FilterExecutor::InitBatch() { child_->InitBatch(); }
+
+auto FilterExecutor::NextBatch(size_t max_rows) -> ChunkUptr
+{
+  for (auto chunk = child_->NextBatch(max_rows); chunk != nullptr; chunk = child_->NextBatch(max_rows)) {
+    std::vector<uint32_t> selection;
+    if (has_conds_) {
+      selection = ConditionExpr::Eval(conds_, *chunk);
+    } else {
+      selection.reserve(chunk->GetSize());
+      for (size_t row = 0; row < chunk->GetSize(); ++row) {
+        arena_.Reset();
+        if (Pass(chunk->GetRecordView(row, arena_))) {
+          selection.push_back(static_cast<uint32_t>(chunk->GetRowIndex(row)));
+        }
+      }
+    }
+    if (!selection.empty()) {
+      chunk->SetSelection(std::move(selection));
+      return chunk;
+    }
+  }
+  return nullptr;
 }
 
 auto FilterExecutor::GetOutSchema() const -> const RecordSchema * { return child_->GetOutSchema(); }
@@ -28,13 +28,20 @@
 #define WSDB_EXECUTOR_FILTER_H
 #include <functional>
 #include "executor_abstract.h"
+#include "common/arena.h"
+#include "common/condition.h"
 
 namespace wsdb {
 
 class FilterExecutor : public AbstractExecutor
 {
 public:
-  FilterExecutor(AbstractExecutorUptr child, std::function<bool(const Record &)> filter);
+  FilterExecutor(AbstractExecutorUptr child, std::function<bool(const RecordView &)> filter);
+
+  /**
+   * Filter by conditions, which the batch path evaluates on the columns of the chunks
+   */
+  FilterExecutor(AbstractExecutorUptr child, ConditionVec conds);
 
   void Init() override;
 
@@ -44,9 +51,27 @@ public:
 
   [[nodiscard]] auto GetOutSchema() const -> const RecordSchema * override;
 
+  [[nodiscard]] auto GetRecordView() const -> RecordView override;
+
+  void InitBatch() override;
+
+  /**
+   * Select the rows of the chunks of the child that pass the filter, chunks without any are skipped
+   */
+  auto NextBatch(size_t max_rows) -> ChunkUptr override;
+
+  [[nodiscard]] auto SupportsBatch() const -> bool override { return child_->SupportsBatch(); }
+
+private:
+  [[nodiscard]] auto Pass(const RecordView &record) const -> bool;
+
 private:
-  AbstractExecutorUptr                child_;
-  std::function<bool(const Record &)> filter_;
+  AbstractExecutorUptr                    child_;
+  std::function<bool(const RecordView &)> filter_;
+  ConditionVec                            conds_;
+  bool                                    has_conds_{false};
+  // without conditions, rows of a chunk are gathered here to be evaluated by filter_
+  Arena arena_;
 };
 
 }  // namespace wsdb
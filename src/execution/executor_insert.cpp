@@ -39,9 +39,11 @@ void InsertExecutor::Next()
   int count = 0;
 
   //WSDB_STUDENT_TODO(l2, t1);
+  auto strategy = tbl_->CreateInsertStrategy(inserts_.size());
+  tbl_->ReservePages(inserts_.size());
   for (auto& record : inserts_)
   {
-    tbl_->InsertRecord(*record);  // 记录插入到表
+    tbl_->InsertRecord(*record, strategy.get());  // 记录插入到表
     for (auto& index : indexes_)
     {
       index->InsertRecord(*record);  // 记录插入到索引
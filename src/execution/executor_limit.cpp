@@ -20,6 +20,7 @@
 //
 
 #include "executor_limit.h"
+#include <algorithm>
 
 namespace wsdb {
 LimitExecutor::LimitExecutor(AbstractExecutorUptr child, int limit)
@@ -31,32 +32,55 @@ void LimitExecutor::Init()
   //WSDB_STUDENT_TODO(l2, t1);
   child_->Init();
   count_ = 0;
-  record_ = nullptr;
+  end_   = true;
 
-  if (child_->IsEnd()) return;
+  if (limit_ <= 0 || child_->IsEnd()) return;
 
-  // 如果执行器不为空：有记录的初始状态
-  record_ = child_->GetRecord();
+  // 如果执行器不为空：有记录的初始状态, the record is the current one of the child
+  end_ = false;
   count_++;
 }
 
 void LimitExecutor::Next()
 {
   //WSDB_STUDENT_TODO(l2, t1);
-  // check
-  if (count_ >= limit_ || child_->IsEnd()) return;
+  // check, the current record is the last of the limit once count_ reaches it
+  if (end_ || count_ >= limit_) {
+    end_ = true;
+    return;
+  }
 
   child_->Next();
-  if (child_->IsEnd()) return;
+  end_ = child_->IsEnd();
+  if (end_) return;
 
-  record_ = child_->GetRecord();
   count_++;
 }
 
 [[nodiscard]] auto LimitExecutor::IsEnd() const -> bool
 {
   //WSDB_STUDENT_TODO(l2, t1);
-  return count_ >= limit_ || child_->IsEnd();
+  return end_;
+}
+
+auto LimitExecutor::GetRecordView() const -> RecordView { return end_ ? RecordView() : child_->GetRecordView(); }
+
+void LimitExecutor::InitBatch()
+{
+  child_->InitBatch();
+  count_ = 0;
+}
+
+auto LimitExecutor::NextBatch(size_t max_rows) -> ChunkUptr
+{
+  if (count_ >= limit_) {
+    return nullptr;
+  }
+  auto chunk = child_->NextBatch(std::min(max_rows, static_cast<size_t>(limit_ - count_)));
+  if (chunk != nullptr) {
+    count_ += static_cast<int>(chunk->GetSize());
+  }
+  return chunk;
 }
 
 [[nodiscard]] auto LimitExecutor::GetOutSchema() const -> const RecordSchema * { return child_->GetOutSchema(); }
@@ -43,12 +43,25 @@ public:
 
   [[nodiscard]] auto GetOutSchema() const -> const RecordSchema * override;
 
+  [[nodiscard]] auto GetRecordView() const -> RecordView override;
+
+  void InitBatch() override;
+
+  /**
+   * Chunks of the child, which is asked for no more rows than are left to the limit
+   */
+  auto NextBatch(size_t max_rows) -> ChunkUptr override;
+
+  [[nodiscard]] auto SupportsBatch() const -> bool override { return child_->SupportsBatch(); }
+
 private:
   AbstractExecutorUptr child_;
   // max number of records to return
   int limit_;
   // current number of records returned
   int count_;
+  // no current record, either the limit is reached or the child is exhausted
+  bool end_{true};
 };
 }  // namespace wsdb
 
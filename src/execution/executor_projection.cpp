@@ -20,49 +20,93 @@
 //
 
 #include "executor_projection.h"
+#include <algorithm>
+#include <cstring>
 
 namespace wsdb {
 
 ProjectionExecutor::ProjectionExecutor(AbstractExecutorUptr child, RecordSchemaUptr proj_schema)
     : AbstractExecutor(Basic), child_(std::move(child))
 {
-  out_schema_ = std::move(proj_schema);
+  out_schema_              = std::move(proj_schema);
+  const auto *child_schema = child_->GetOutSchema();
+  for (size_t i = 0; i < out_schema_->GetFieldCount(); ++i) {
+    auto idx = child_schema->GetRTFieldIndex(out_schema_->GetFieldAt(i));
+    if (idx == child_schema->GetFieldCount()) {
+      WSDB_FETAL("Field not found in child schema");
+    }
+    col_idx_.push_back(idx);
+  }
 }
 
-// hint: record_ = std::make_unique<Record>(out_schema_.get(), *child_record);
-
 void ProjectionExecutor::Init()
 {
   //WSDB_STUDENT_TODO(l2, t1);
   child_->Init();
-  record_ = nullptr;
-
-  if (child_->IsEnd()) return;
-
-  if (child_->GetRecord() != nullptr)
-  {
-    record_ = std::make_unique<Record>(out_schema_.get(), *child_->GetRecord());
-  }
+  Project();
 }
 
 void ProjectionExecutor::Next()
 {
   //WSDB_STUDENT_TODO(l2, t1);
-  record_ = nullptr;
   child_->Next();
+  Project();
+}
 
+void ProjectionExecutor::Project()
+{
+  view_ = RecordView();
   if (child_->IsEnd()) return;
 
-  if (child_->GetRecord() != nullptr)
-  {
-    record_ = std::make_unique<Record>(out_schema_.get(), *child_->GetRecord());
+  // the projected record of the previous row is dropped, after the first row this does not allocate
+  auto child        = child_->GetRecordView();
+  auto nullmap_size = BITMAP_SIZE(out_schema_->GetFieldCount());
+  arena_.Reset();
+  auto nullmap = arena_.Allocate(nullmap_size, 1);
+  auto data    = arena_.Allocate(out_schema_->GetRecordLength());
+  memset(nullmap, 0, nullmap_size);
+  for (size_t i = 0; i < col_idx_.size(); ++i) {
+    if (child.IsNull(col_idx_[i])) {
+      BitMap::SetBit(nullmap, i, true);
+    }
+    memcpy(data + out_schema_->GetFieldOffset(i), child.GetFieldData(col_idx_[i]),
+        out_schema_->GetFieldAt(i).field_.field_size_);
+  }
+  view_ = RecordView(out_schema_.get(), nullmap, data, INVALID_RID);
+}
+
+auto ProjectionExecutor::GetRecordView() const -> RecordView { return view_; }
+
+void ProjectionExecutor::InitBatch() { child_->InitBatch(); }
+
+auto ProjectionExecutor::NextBatch(size_t max_rows) -> ChunkUptr
+{
+  auto chunk = child_->NextBatch(max_rows);
+  if (chunk == nullptr) {
+    return nullptr;
+  }
+  std::vector<ColumnVector> cols;
+  cols.reserve(col_idx_.size());
+  for (size_t i = 0; i < col_idx_.size(); ++i) {
+    // the child chunk is dropped afterwards, so a column is moved out of it unless it was projected before
+    auto prev = std::find(col_idx_.begin(), col_idx_.begin() + static_cast<long>(i), col_idx_[i]);
+    if (prev != col_idx_.begin() + static_cast<long>(i)) {
+      cols.push_back(cols[prev - col_idx_.begin()]);
+    } else {
+      cols.push_back(std::move(chunk->GetCol(col_idx_[i])));
+    }
+  }
+  auto out = std::make_unique<Chunk>(out_schema_.get(), std::move(cols));
+  if (chunk->HasSelection()) {
+    out->SetSelection(chunk->GetSelection());
   }
+  return out;
 }
 
 auto ProjectionExecutor::IsEnd() const -> bool
 {
   //WSDB_STUDENT_TODO(l2, t1);
-  return child_->IsEnd() || record_ == nullptr;
+  return child_->IsEnd() || !view_.IsValid();
 }
 
 }  // namespace wsdb
\ No newline at end of file
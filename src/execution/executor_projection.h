@@ -28,6 +28,7 @@
 #define WSDB_EXECUTOR_PROJECTION_H
 
 #include "executor_abstract.h"
+#include "common/arena.h"
 
 namespace wsdb {
 class ProjectionExecutor : public AbstractExecutor
@@ -41,8 +42,29 @@ public:
 
   [[nodiscard]] auto IsEnd() const -> bool override;
 
+  [[nodiscard]] auto GetRecordView() const -> RecordView override;
+
+  void InitBatch() override;
+
+  /**
+   * Pick the columns of the chunks of the child, the selection is kept as is
+   */
+  auto NextBatch(size_t max_rows) -> ChunkUptr override;
+
+  [[nodiscard]] auto SupportsBatch() const -> bool override { return child_->SupportsBatch(); }
+
+private:
+  /**
+   * Project the current record of the child into the arena, view_ is invalid at the end
+   */
+  void Project();
+
 private:
   AbstractExecutorUptr child_;
+  // index in the child schema of each field of the out schema
+  std::vector<size_t> col_idx_;
+  Arena               arena_;
+  RecordView          view_;
 };
 }  // namespace wsdb
 
@@ -27,29 +27,89 @@ SeqScanExecutor::SeqScanExecutor(TableHandle *tab) : AbstractExecutor(Basic), ta
 
 void SeqScanExecutor::Init()
 {
-  rid_ = tab_->GetFirstRID();
+  strategy_ = tab_->CreateScanStrategy();
+  // start reading while the first pages are examined, sequential detection keeps the windows going
+  tab_->Prefetch(FILE_HEADER_PAGE_ID + 1, BUFFER_READAHEAD_MIN, strategy_.get());
+  page_id_  = FILE_HEADER_PAGE_ID;
 
   //WSDB_STUDENT_TODO(l2, t1);
-  record_ = (rid_ != INVALID_RID) ? tab_->GetRecord(rid_) : nullptr;
+  NextPage();
 }
 
 void SeqScanExecutor::Next()
 {
   //WSDB_STUDENT_TODO(l2, t1);
-  if (record_ != nullptr)
+  if (batch_idx_ < batch_.size())
   {
-    // 仅在当前记录有效时尝试获取下一条
-    rid_ = tab_->GetNextRID(rid_);
-    record_ = (rid_ != INVALID_RID) ? tab_->GetRecord(rid_) : nullptr;
+    // 仅在当前记录有效时尝试获取下一条, the page is only fetched again once its batch is used up
+    if (++batch_idx_ == batch_.size()) {
+      NextPage();
+    }
   }
 }
 
+void SeqScanExecutor::NextPage()
+{
+  batch_idx_ = 0;
+  while (static_cast<size_t>(++page_id_) < tab_->GetTableHeader().page_num_) {
+    // the records of the previous page are dropped at once
+    arena_.Reset();
+    tab_->GetPageRecords(page_id_, arena_, batch_, strategy_.get());
+    if (!batch_.empty()) {
+      return;
+    }
+  }
+  batch_.clear();
+}
+
+void SeqScanExecutor::InitBatch()
+{
+  strategy_ = tab_->CreateScanStrategy();
+  tab_->Prefetch(FILE_HEADER_PAGE_ID + 1, BUFFER_READAHEAD_MIN, strategy_.get());
+  page_id_      = FILE_HEADER_PAGE_ID;
+  batch_.clear();
+  batch_idx_    = 0;
+  chunk_        = nullptr;
+  chunk_offset_ = 0;
+}
+
+auto SeqScanExecutor::NextBatch(size_t max_rows) -> ChunkUptr
+{
+  while (chunk_ == nullptr || chunk_offset_ == chunk_->GetSize()) {
+    if (static_cast<size_t>(page_id_ + 1) >= tab_->GetTableHeader().page_num_) {
+      chunk_ = nullptr;
+      return nullptr;
+    }
+    ++page_id_;
+    if (tab_->GetStorageModel() == PAX_MODEL) {
+      chunk_ = tab_->GetChunk(page_id_, GetOutSchema(), strategy_.get());
+    } else {
+      arena_.Reset();
+      tab_->GetPageRecords(page_id_, arena_, batch_, strategy_.get());
+      chunk_ = Chunk::FromRecords(GetOutSchema(), batch_);
+    }
+    chunk_offset_ = 0;
+  }
+  auto count = std::min(max_rows, chunk_->GetSize() - chunk_offset_);
+  if (chunk_offset_ == 0 && count == chunk_->GetSize()) {
+    return std::move(chunk_);
+  }
+  auto chunk = chunk_->Slice(chunk_offset_, count);
+  chunk_offset_ += count;
+  return chunk;
+}
+
 auto SeqScanExecutor::IsEnd() const -> bool
 {
   //WSDB_STUDENT_TODO(l2, t1);
-  return record_ == nullptr;
+  return batch_idx_ >= batch_.size();
   // 如果当前没有记录，表示扫描结束
 }
 
+auto SeqScanExecutor::GetRecordView() const -> RecordView
+{
+  return IsEnd() ? RecordView() : batch_[batch_idx_];
+}
+
 auto SeqScanExecutor::GetOutSchema() const -> const RecordSchema * { return &tab_->GetSchema(); }
 }  // namespace wsdb
\ No newline at end of file
@@ -43,9 +43,36 @@ public:
 
   [[nodiscard]] auto GetOutSchema() const -> const RecordSchema * override;
 
+  [[nodiscard]] auto GetRecordView() const -> RecordView override;
+
+  void InitBatch() override;
+
+  /**
+   * Chunks of the pages in order, PAX pages are read column-wise, a page with more than max_rows rows is handed out
+   * in slices
+   */
+  auto NextBatch(size_t max_rows) -> ChunkUptr override;
+
+  [[nodiscard]] auto SupportsBatch() const -> bool override { return true; }
+
+private:
+  /**
+   * Decode the records of the pages after page_id_ until a page has some, batch_ is empty if none is left
+   */
+  void NextPage();
+
 private:
   TableHandle *tab_;
-  RID          rid_;
+  // the scan reads a page at a time into the arena, the current record is batch_[batch_idx_] of page page_id_
+  page_id_t               page_id_{INVALID_PAGE_ID};
+  Arena                   arena_;
+  std::vector<RecordView> batch_;
+  size_t                  batch_idx_{0};
+  // for NextBatch, the chunk of page page_id_ of which rows before chunk_offset_ are handed out
+  ChunkUptr chunk_;
+  size_t    chunk_offset_{0};
+  // ring of frames the scan recycles when the table is large, so that it does not flush the shared pool
+  BufferAccessStrategyUptr strategy_;
 };
 }  // namespace wsdb
 
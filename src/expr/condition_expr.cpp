@@ -20,32 +20,133 @@
 //
 
 #include "condition_expr.h"
+#include <cstring>
+#include <string_view>
 
 namespace wsdb {
 
-auto ConditionExpr::Eval(const ConditionVec &condition, const wsdb::Record &record) -> bool
+namespace {
+
+// an operand of a comparison, it refers to the raw value of a field or to the value held by a Value
+struct Operand
 {
-  return std::all_of(
-      condition.begin(), condition.end(), [&record](const Condition &cond) { return EvalCond(cond, record); });
+  Operand(FieldType type, bool is_null) : type_(type), is_null_(is_null) {}
+
+  FieldType        type_{TYPE_NULL};
+  bool             is_null_{false};
+  int32_t          int_{0};
+  float            float_{0};
+  bool             bool_{false};
+  std::string_view string_;
+};
+
+auto MakeOperand(const RecordView &record, size_t idx) -> Operand
+{
+  const auto &field = record.GetSchema()->GetFieldAt(idx).field_;
+  Operand     op(field.field_type_, record.IsNull(idx));
+  if (op.is_null_) {
+    return op;
+  }
+  const char *data = record.GetFieldData(idx);
+  switch (op.type_) {
+    case TYPE_INT: memcpy(&op.int_, data, sizeof(op.int_)); break;
+    case TYPE_FLOAT: memcpy(&op.float_, data, sizeof(op.float_)); break;
+    case TYPE_BOOL: memcpy(&op.bool_, data, sizeof(op.bool_)); break;
+    case TYPE_STRING: op.string_ = std::string_view(data, strnlen(data, field.field_size_)); break;
+    default: op.type_ = TYPE_NULL;
+  }
+  return op;
 }
 
-auto ConditionExpr::EvalCond(const Condition &condition, const wsdb::Record &record) -> bool
+auto MakeOperand(const ColumnVector &col, size_t idx) -> Operand
 {
-  // first get the lhs value according to condition
-  auto idx = record.GetSchema()->GetRTFieldIndex(condition.GetLCol());
-  WSDB_ASSERT(idx != record.GetSchema()->GetFieldCount(), "Invalid field");
-  auto lhs = record.GetValueAt(idx);
-  WSDB_ASSERT(condition.GetRhsType() == kValue || condition.GetRhsType() == kColumn, "Invalid condition type");
-  ValueSptr rhs;
-  if (condition.GetRhsType() == kValue) {
-    rhs = condition.GetRVal();
+  Operand op(col.GetType(), col.IsNull(idx));
+  if (op.is_null_) {
+    return op;
+  }
+  const char *data = col.GetRawData() + idx * col.GetWidth();
+  switch (op.type_) {
+    case TYPE_INT: memcpy(&op.int_, data, sizeof(op.int_)); break;
+    case TYPE_FLOAT: memcpy(&op.float_, data, sizeof(op.float_)); break;
+    case TYPE_BOOL: memcpy(&op.bool_, data, sizeof(op.bool_)); break;
+    case TYPE_STRING: op.string_ = col.GetString(idx); break;
+    default: op.type_ = TYPE_NULL;
+  }
+  return op;
+}
+
+auto MakeOperand(const Value &value) -> Operand
+{
+  Operand op(value.GetType(), value.IsNull());
+  switch (op.type_) {
+    case TYPE_INT: op.int_ = dynamic_cast<const IntValue &>(value).Get(); break;
+    case TYPE_FLOAT: op.float_ = dynamic_cast<const FloatValue &>(value).Get(); break;
+    case TYPE_BOOL: op.bool_ = dynamic_cast<const BoolValue &>(value).Get(); break;
+    case TYPE_STRING: op.string_ = dynamic_cast<const StringValue &>(value).Get(); break;
+    default: op.type_ = TYPE_NULL;
+  }
+  return op;
+}
+
+template <typename T>
+auto ThreeWay(const T &lhs, const T &rhs) -> int
+{
+  return lhs < rhs ? -1 : (rhs < lhs ? 1 : 0);
+}
+
+/**
+ * Compare two operands as the operators of Value do, int is aligned to float
+ * @return false if the types are not comparable here, left to the Value path
+ */
+auto Compare(const Operand &lhs, const Operand &rhs, CompOp op, bool &result) -> bool
+{
+  bool numeric = (lhs.type_ == TYPE_INT || lhs.type_ == TYPE_FLOAT) && (rhs.type_ == TYPE_INT || rhs.type_ == TYPE_FLOAT);
+  if (lhs.type_ == TYPE_NULL || (lhs.type_ != rhs.type_ && !numeric)) {
+    return false;
+  }
+  if (lhs.is_null_ || rhs.is_null_) {
+    // null equals null only, and is not ordered
+    bool both_null = lhs.is_null_ && rhs.is_null_;
+    switch (op) {
+      case OP_EQ: result = both_null; return true;
+      case OP_NE: result = !both_null; return true;
+      case OP_LT:
+      case OP_LE:
+      case OP_GT:
+      case OP_GE: result = false; return true;
+      default: return false;
+    }
+  }
+  int cmp;
+  if (lhs.type_ == TYPE_INT && rhs.type_ == TYPE_INT) {
+    cmp = ThreeWay(lhs.int_, rhs.int_);
+  } else if (numeric) {
+    auto l = lhs.type_ == TYPE_INT ? static_cast<float>(lhs.int_) : lhs.float_;
+    auto r = rhs.type_ == TYPE_INT ? static_cast<float>(rhs.int_) : rhs.float_;
+    cmp    = ThreeWay(l, r);
+  } else if (lhs.type_ == TYPE_BOOL) {
+    cmp = ThreeWay(lhs.bool_, rhs.bool_);
   } else {
-    idx = record.GetSchema()->GetRTFieldIndex(condition.GetRCol());
-    WSDB_ASSERT(idx != record.GetSchema()->GetFieldCount(), "Invalid field");
-    rhs = record.GetValueAt(idx);
+    cmp = ThreeWay(lhs.string_, rhs.string_);
+  }
+  switch (op) {
+    case OP_EQ: result = cmp == 0; return true;
+    case OP_NE: result = cmp != 0; return true;
+    case OP_LT: result = cmp < 0; return true;
+    case OP_LE: result = cmp <= 0; return true;
+    case OP_GT: result = cmp > 0; return true;
+    case OP_GE: result = cmp >= 0; return true;
+    default: return false;
   }
+}
+
+/**
+ * Compare two values with the operators of Value, for what the raw operands do not cover
+ */
+auto CompareValues(ValueSptr lhs, ValueSptr rhs, CompOp op) -> bool
+{
   ValueFactory::AlignTypes(lhs, rhs);
-  switch (condition.GetOp()) {
+  switch (op) {
     case OP_EQ: return *lhs == *rhs;
     case OP_NE: return *lhs != *rhs;
     case OP_LT: return *lhs < *rhs;
@@ -53,9 +154,92 @@ auto ConditionExpr::EvalCond(const Condition &condition, const wsdb::Record &rec
     case OP_GT: return *lhs > *rhs;
     case OP_GE: return *lhs >= *rhs;
     case OP_IN: return std::dynamic_pointer_cast<ArrayValue>(rhs)->Contains(lhs);
-    default: WSDB_FETAL(CompOpToString(condition.GetOp()));
+    default: WSDB_FETAL(CompOpToString(op));
+  }
+}
+
+}  // namespace
+
+auto ConditionExpr::Eval(const ConditionVec &condition, const wsdb::Record &record) -> bool
+{
+  return Eval(condition, RecordView(record));
+}
+
+auto ConditionExpr::Eval(const ConditionVec &condition, const RecordView &record) -> bool
+{
+  return std::all_of(
+      condition.begin(), condition.end(), [&record](const Condition &cond) { return EvalCond(cond, record); });
+}
+
+auto ConditionExpr::EvalCond(const Condition &condition, const RecordView &record) -> bool
+{
+  // first get the lhs value according to condition
+  auto lidx = record.GetSchema()->GetRTFieldIndex(condition.GetLCol());
+  WSDB_ASSERT(lidx != record.GetSchema()->GetFieldCount(), "Invalid field");
+  WSDB_ASSERT(condition.GetRhsType() == kValue || condition.GetRhsType() == kColumn, "Invalid condition type");
+  size_t ridx = 0;
+  if (condition.GetRhsType() == kColumn) {
+    ridx = record.GetSchema()->GetRTFieldIndex(condition.GetRCol());
+    WSDB_ASSERT(ridx != record.GetSchema()->GetFieldCount(), "Invalid field");
+  }
+  // fast path on the raw values
+  if (condition.GetOp() != OP_IN) {
+    auto lhs = MakeOperand(record, lidx);
+    auto rhs = condition.GetRhsType() == kValue ? MakeOperand(*condition.GetRVal()) : MakeOperand(record, ridx);
+    bool result;
+    if (Compare(lhs, rhs, condition.GetOp(), result)) {
+      return result;
+    }
+  }
+  ValueSptr rhs = condition.GetRhsType() == kValue ? condition.GetRVal() : record.GetValueAt(ridx);
+  return CompareValues(record.GetValueAt(lidx), rhs, condition.GetOp());
+}
+
+auto ConditionExpr::Eval(const ConditionVec &condition, const Chunk &chunk) -> std::vector<uint32_t>
+{
+  std::vector<uint32_t> selection(chunk.GetSize());
+  for (size_t row = 0; row < chunk.GetSize(); ++row) {
+    selection[row] = static_cast<uint32_t>(chunk.GetRowIndex(row));
+  }
+  for (const auto &cond : condition) {
+    if (selection.empty()) {
+      break;
+    }
+    EvalCond(cond, chunk, selection);
+  }
+  return selection;
+}
+
+void ConditionExpr::EvalCond(const Condition &condition, const Chunk &chunk, std::vector<uint32_t> &selection)
+{
+  auto schema = chunk.GetSchema();
+  auto lidx   = schema->GetRTFieldIndex(condition.GetLCol());
+  WSDB_ASSERT(lidx != schema->GetFieldCount(), "Invalid field");
+  WSDB_ASSERT(condition.GetRhsType() == kValue || condition.GetRhsType() == kColumn, "Invalid condition type");
+  const auto         &lcol = chunk.GetCol(lidx);
+  const ColumnVector *rcol = nullptr;
+  Operand             rval(TYPE_NULL, false);
+  if (condition.GetRhsType() == kColumn) {
+    auto ridx = schema->GetRTFieldIndex(condition.GetRCol());
+    WSDB_ASSERT(ridx != schema->GetFieldCount(), "Invalid field");
+    rcol = &chunk.GetCol(ridx);
+  } else {
+    rval = MakeOperand(*condition.GetRVal());
+  }
+  // keep the rows that pass in place, same fast path as for a record
+  size_t kept = 0;
+  for (auto idx : selection) {
+    bool result;
+    if (condition.GetOp() == OP_IN ||
+        !Compare(MakeOperand(lcol, idx), rcol != nullptr ? MakeOperand(*rcol, idx) : rval, condition.GetOp(), result)) {
+      ValueSptr rhs = rcol != nullptr ? rcol->GetValue(idx) : condition.GetRVal();
+      result        = CompareValues(lcol.GetValue(idx), rhs, condition.GetOp());
+    }
+    if (result) {
+      selection[kept++] = idx;
+    }
   }
-  // should never reach here
+  selection.resize(kept);
 }
 
 }  // namespace wsdb
\ No newline at end of file
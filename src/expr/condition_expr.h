@@ -35,8 +35,25 @@ public:
 
   static auto Eval(const ConditionVec &condition, const Record &record)-> bool;
 
+  /**
+   * Comparisons of int, float, bool and string fields are evaluated on the raw values of the record without
+   * boxing them into Values, so that they do not allocate
+   */
+  static auto Eval(const ConditionVec &condition, const RecordView &record) -> bool;
+
+  /**
+   * Evaluate the conditions on the columns of a chunk, same semantics as for a record
+   * @return indexes in the columns of the selected rows that pass, in the order of the chunk
+   */
+  static auto Eval(const ConditionVec &condition, const Chunk &chunk) -> std::vector<uint32_t>;
+
 private:
-  static auto EvalCond(const Condition &condition, const Record &record) -> bool;
+  static auto EvalCond(const Condition &condition, const RecordView &record) -> bool;
+
+  /**
+   * Drop from selection the rows that do not pass the condition
+   */
+  static void EvalCond(const Condition &condition, const Chunk &chunk, std::vector<uint32_t> &selection);
 };
 
 }  // namespace wsdb
@@ -21,6 +21,7 @@
 
 #include "net_controller.h"
 
+#include <algorithm>
 #include <sys/socket.h>
 #include <netinet/in.h>
 
@@ -114,18 +115,51 @@ void NetController::SendRecHeader(int fd, const RecordSchema *header)
   memcpy(pkg_.buf_, header_str.c_str(), pkg_.len_);
   FlushSend(fd);
 }
-void NetController::SendRec(int fd, const Record *rec)
+void NetController::SendRec(int fd, const Record *rec) { SendRec(fd, RecordView(*rec)); }
+
+void NetController::SendRec(int fd, const RecordView &rec)
 {
-  // append record to buffer and flush if buffer is full
-  auto &pkg_ = client_buffer_[fd];
-  pkg_.type_ = net::NET_PKG_REC_BODY;
   // record format: {field_value}\t{field_value}\t ...
   std::string rec_str;
-  for (int i = 0; i < static_cast<int>(rec->GetSchema()->GetFieldCount()); ++i) {
-    auto v = rec->GetValueAt(i);
+  for (int i = 0; i < static_cast<int>(rec.GetSchema()->GetFieldCount()); ++i) {
+    auto v = rec.GetValueAt(i);
     rec_str += v->ToString();
     rec_str += '\t';
   }
+  SendRecString(fd, rec_str);
+}
+
+void NetController::SendChunk(int fd, const Chunk *chunk)
+{
+  // same format as SendRec, written straight from the values of the columns instead of a Value per field
+  std::string rec_str;
+  for (size_t row = 0; row < chunk->GetSize(); ++row) {
+    rec_str.clear();
+    auto idx = chunk->GetRowIndex(row);
+    for (size_t i = 0; i < chunk->GetColCount(); ++i) {
+      const auto &col = chunk->GetCol(i);
+      if (col.IsNull(idx)) {
+        rec_str += "(null)";
+      } else {
+        switch (col.GetType()) {
+          case FieldType::TYPE_INT: rec_str += std::to_string(col.GetData<int32_t>()[idx]); break;
+          case FieldType::TYPE_FLOAT: rec_str += std::to_string(col.GetData<float>()[idx]); break;
+          case FieldType::TYPE_BOOL: rec_str += std::to_string(col.GetData<bool>()[idx]); break;
+          case FieldType::TYPE_STRING: rec_str += col.GetString(idx); break;
+          default: WSDB_FETAL(fmt::format("unsupported column type {}", FieldTypeToString(col.GetType())));
+        }
+      }
+      rec_str += '\t';
+    }
+    SendRecString(fd, rec_str);
+  }
+}
+
+void NetController::SendRecString(int fd, const std::string &rec_str)
+{
+  // append record to buffer and flush if buffer is full
+  auto &pkg_ = client_buffer_[fd];
+  pkg_.type_ = net::NET_PKG_REC_BODY;
   // FIXME: accumulate records and send, may cause client waiting sometimes
   //  if (pkg_.len_ + rec_str.size() > net::NET_BUFFER_SIZE) {
   //    FlushSend(fd);
@@ -165,11 +199,23 @@ void NetController::SendOK(int fd)
 
 void NetController::SendRawString(int fd, const std::string &str)
 {
-  auto &pkg_ = client_buffer_[fd];
-  pkg_.type_ = net::NET_PKG_RAW_STRING;
-  pkg_.len_  = str.size();
-  memcpy(pkg_.buf_, str.c_str(), pkg_.len_);
-  FlushSend(fd);
+  auto  &pkg_   = client_buffer_[fd];
+  size_t offset = 0;
+  // a string longer than the package buffer is sent in several packages, cut at line ends where possible
+  do {
+    auto len = std::min(str.size() - offset, static_cast<size_t>(net::NET_BUFFER_SIZE));
+    if (offset + len < str.size()) {
+      auto line_end = str.rfind('\n', offset + len - 1);
+      if (line_end != std::string::npos && line_end >= offset) {
+        len = line_end + 1 - offset;
+      }
+    }
+    pkg_.type_ = net::NET_PKG_RAW_STRING;
+    pkg_.len_  = len;
+    memcpy(pkg_.buf_, str.c_str() + offset, len);
+    FlushSend(fd);
+    offset += len;
+  } while (offset < str.size());
 }
 
 void NetController::FlushSend(int fd)
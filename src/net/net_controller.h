@@ -45,12 +45,18 @@ public:
   /// record will be stored until buffer is full and flush to socket
   void SendRec(int fd, const Record *rec);
 
+  void SendRec(int fd, const RecordView &rec);
+
+  /// rows of the chunk in the format of SendRec, values are read from the columns without building records
+  void SendChunk(int fd, const Chunk *chunk);
+
   void SendRecFinish(int fd);
 
   void SendError(int fd, const std::string &error_msg);
 
   void SendOK(int fd);
 
+  /// the string is split into packages of at most NET_BUFFER_SIZE bytes, at line ends where possible
   void SendRawString(int fd, const std::string &str);
 
   void FlushSend(int fd);
@@ -58,6 +64,8 @@ public:
   void Remove(int fd);
 
 private:
+  void SendRecString(int fd, const std::string &rec_str);
+
   // currently receive and send use the same pkg_
   int                                  server_fd_{0};
   int                                  listen_port_{0};
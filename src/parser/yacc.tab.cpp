@@ -83,6 +83,7 @@ See the Mulan PSL v2 for more details. */
 #include "yacc.tab.h"
 #include <iostream>
 #include <memory>
+#include <strings.h>
 
 int yylex(YYSTYPE *yylval, YYLTYPE *yylloc);
 
@@ -93,7 +94,7 @@ void yyerror(YYLTYPE *locp, const char* s) {
 using namespace wsdb;
 using namespace ast;
 
-#line 97 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 98 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -570,18 +571,18 @@ union yyalloc
 #endif /* !YYCOPY_NEEDED */
 
 /* YYFINAL -- State number of the termination state.  */
-#define YYFINAL  55
+#define YYFINAL  56
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   228
+#define YYLAST   232
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  78
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  43
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  117
+#define YYNRULES  118
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  223
+#define YYNSTATES  225
 
 /* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   323
@@ -637,18 +638,18 @@ static const yytype_int8 yytranslate[] =
 /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,    74,    74,    80,    85,    90,    95,   103,   104,   105,
-     106,   107,   108,   109,   113,   117,   121,   125,   132,   138,
-     142,   146,   153,   159,   163,   167,   171,   175,   182,   183,
-     185,   190,   194,   198,   202,   209,   216,   220,   224,   228,
-     235,   239,   246,   253,   257,   261,   265,   272,   276,   283,
-     287,   291,   295,   300,   306,   310,   317,   318,   325,   329,
-     333,   337,   345,   346,   353,   354,   356,   360,   368,   369,
-     375,   379,   383,   387,   395,   399,   406,   410,   417,   421,
-     425,   429,   433,   437,   445,   450,   455,   460,   468,   472,
-     476,   480,   484,   488,   492,   496,   503,   507,   514,   518,
-     525,   532,   536,   540,   544,   548,   552,   556,   563,   567,
-     574,   578,   582,   589,   590,   591,   594,   596
+       0,    75,    75,    81,    86,    91,    96,   104,   105,   106,
+     107,   108,   109,   110,   114,   118,   122,   126,   133,   139,
+     143,   152,   156,   163,   169,   173,   177,   181,   185,   192,
+     193,   195,   200,   204,   208,   212,   219,   226,   230,   234,
+     238,   245,   249,   256,   263,   267,   271,   275,   282,   286,
+     293,   297,   301,   305,   310,   316,   320,   327,   328,   335,
+     339,   343,   347,   355,   356,   363,   364,   366,   370,   378,
+     379,   385,   389,   393,   397,   405,   409,   416,   420,   427,
+     431,   435,   439,   443,   447,   455,   460,   465,   470,   478,
+     482,   486,   490,   494,   498,   502,   506,   513,   517,   524,
+     528,   535,   542,   546,   550,   554,   558,   562,   566,   573,
+     577,   584,   588,   592,   599,   600,   601,   604,   606
 };
 #endif
 
@@ -693,12 +694,12 @@ yysymbol_name (yysymbol_kind_t yysymbol)
 }
 #endif
 
-#define YYPACT_NINF (-142)
+#define YYPACT_NINF (-144)
 
 #define yypact_value_is_default(Yyn) \
   ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF (-117)
+#define YYTABLE_NINF (-118)
 
 #define yytable_value_is_error(Yyn) \
   0
@@ -707,29 +708,29 @@ yysymbol_name (yysymbol_kind_t yysymbol)
    STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-      78,   127,     6,   132,    14,   -50,    13,    22,    39,   -50,
-      19,  -142,  -142,  -142,  -142,  -142,  -142,  -142,    70,     3,
-    -142,  -142,  -142,  -142,  -142,  -142,  -142,    10,  -142,    66,
-     -50,    11,  -142,   -50,   -50,   -50,  -142,  -142,   -50,   -50,
-      21,    54,    31,    68,    74,    76,    77,    18,  -142,   130,
-     130,    85,   136,    92,  -142,  -142,  -142,  -142,   -50,    95,
-    -142,   110,  -142,   111,   172,   152,  -142,   122,   123,   123,
-     123,   123,   -52,   122,  -142,  -142,    79,   -42,   122,  -142,
-     122,   122,   122,   118,   123,  -142,  -142,   -26,  -142,   117,
-     119,   120,   121,   124,   125,   126,  -142,   130,   130,   156,
-    -142,   -24,    64,  -142,   -21,  -142,    -1,    27,  -142,    43,
-      89,  -142,   151,    35,   122,  -142,    89,  -142,  -142,  -142,
-    -142,  -142,  -142,  -142,  -142,   128,   -42,   178,   -50,   158,
-     159,   144,   122,  -142,   134,  -142,  -142,  -142,  -142,   122,
-    -142,  -142,  -142,  -142,  -142,    50,  -142,   123,   135,  -142,
-    -142,  -142,  -142,  -142,  -142,   105,  -142,  -142,  -142,  -142,
-     184,   186,  -142,   -50,   -50,   137,  -142,  -142,   142,  -142,
-    -142,    89,  -142,    52,   156,  -142,  -142,  -142,     7,   188,
-     177,  -142,  -142,   -25,   141,  -142,   143,    61,   145,  -142,
-    -142,  -142,   123,   123,    79,   183,  -142,  -142,  -142,  -142,
-    -142,  -142,   146,  -142,   146,  -142,  -142,   174,    91,    33,
-     161,   123,    79,    89,  -142,  -142,   149,  -142,  -142,  -142,
-    -142,  -142,  -142
+      80,   129,     2,    94,    14,   -51,    22,    31,    43,   -51,
+      23,  -144,  -144,  -144,  -144,  -144,  -144,  -144,    58,     5,
+    -144,  -144,  -144,  -144,  -144,  -144,  -144,    16,  -144,    77,
+      30,   -51,    36,  -144,   -51,   -51,   -51,  -144,  -144,   -51,
+     -51,    52,    85,    55,    64,    70,    71,    75,    79,  -144,
+     140,   140,    87,   161,   103,  -144,  -144,  -144,  -144,   -51,
+    -144,   106,  -144,   112,  -144,   113,   174,   154,  -144,   124,
+     125,   125,   125,   125,   -41,   124,  -144,  -144,    82,   -44,
+     124,  -144,   124,   124,   124,   120,   125,  -144,  -144,   -21,
+    -144,   119,   121,   122,   123,   126,   127,   128,  -144,   140,
+     140,   158,  -144,   -19,    67,  -144,    -6,  -144,   117,    49,
+    -144,    92,   102,  -144,   153,    42,   124,  -144,   102,  -144,
+    -144,  -144,  -144,  -144,  -144,  -144,  -144,   130,   -44,   180,
+     -51,   160,   162,   146,   124,  -144,   135,  -144,  -144,  -144,
+    -144,   124,  -144,  -144,  -144,  -144,  -144,   100,  -144,   125,
+     137,  -144,  -144,  -144,  -144,  -144,  -144,    84,  -144,  -144,
+    -144,  -144,   186,   188,  -144,   -51,   -51,   138,  -144,  -144,
+     145,  -144,  -144,   102,  -144,   -28,   158,  -144,  -144,  -144,
+       7,   190,   179,  -144,  -144,   -29,   143,  -144,   144,   101,
+     147,  -144,  -144,  -144,   125,   125,    82,   187,  -144,  -144,
+    -144,  -144,  -144,  -144,   148,  -144,   148,  -144,  -144,   173,
+      20,    11,   163,   125,    82,   102,  -144,  -144,   157,  -144,
+    -144,  -144,  -144,  -144,  -144
 };
 
 /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
@@ -739,47 +740,47 @@ static const yytype_int8 yydefact[] =
 {
       13,    13,     0,     0,     0,     0,     0,     0,     0,     0,
        0,     5,     4,    14,    15,    16,    17,     6,     0,     0,
-      10,    12,     7,    11,     8,     9,    34,     0,    19,     0,
-       0,     0,    18,     0,     0,     0,   116,    25,     0,     0,
-       0,     0,     0,     0,     0,     0,     0,   117,   101,    89,
-      89,   102,     0,     0,    77,     1,     2,     3,     0,     0,
-      20,     0,    24,     0,     0,    62,    21,     0,     0,     0,
-       0,     0,     0,     0,    84,    85,     0,     0,     0,    22,
-       0,     0,     0,     0,     0,    32,   117,    62,    98,     0,
-       0,     0,     0,     0,     0,     0,    88,    89,    89,     0,
-     108,    62,   103,    76,     0,    38,     0,     0,    40,     0,
-      53,    74,    63,     0,     0,    33,    53,    79,    80,    81,
-      82,    83,    78,    86,    87,     0,     0,   111,     0,     0,
-       0,    28,     0,    43,     0,    46,    44,    42,    26,     0,
-      27,    51,    49,    50,    52,     0,    47,     0,     0,    94,
-      93,    95,    90,    91,    92,    53,    99,   100,   104,   109,
-       0,    56,   105,     0,     0,     0,    23,    39,     0,    41,
-      31,    53,    75,    53,     0,    96,    97,    58,   115,     0,
-      68,   106,   107,     0,     0,    48,     0,     0,     0,   114,
-     113,   110,     0,     0,     0,    64,    30,    29,    45,    60,
-      61,    59,   112,    54,    57,    70,    71,    69,     0,     0,
-      37,     0,     0,    53,    65,    66,     0,    35,    55,    72,
-      73,    67,    36
+      10,    12,     7,    11,     8,     9,    35,     0,    19,     0,
+       0,     0,     0,    18,     0,     0,     0,   117,    26,     0,
+       0,     0,     0,     0,     0,     0,     0,     0,   118,   102,
+      90,    90,   103,     0,     0,    78,     1,     2,     3,     0,
+      20,     0,    21,     0,    25,     0,     0,    63,    22,     0,
+       0,     0,     0,     0,     0,     0,    85,    86,     0,     0,
+       0,    23,     0,     0,     0,     0,     0,    33,   118,    63,
+      99,     0,     0,     0,     0,     0,     0,     0,    89,    90,
+      90,     0,   109,    63,   104,    77,     0,    39,     0,     0,
+      41,     0,    54,    75,    64,     0,     0,    34,    54,    80,
+      81,    82,    83,    84,    79,    87,    88,     0,     0,   112,
+       0,     0,     0,    29,     0,    44,     0,    47,    45,    43,
+      27,     0,    28,    52,    50,    51,    53,     0,    48,     0,
+       0,    95,    94,    96,    91,    92,    93,    54,   100,   101,
+     105,   110,     0,    57,   106,     0,     0,     0,    24,    40,
+       0,    42,    32,    54,    76,    54,     0,    97,    98,    59,
+     116,     0,    69,   107,   108,     0,     0,    49,     0,     0,
+       0,   115,   114,   111,     0,     0,     0,    65,    31,    30,
+      46,    61,    62,    60,   113,    55,    58,    71,    72,    70,
+       0,     0,    38,     0,     0,    54,    66,    67,     0,    36,
+      56,    73,    74,    68,    37
 };
 
 /* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -142,  -142,   217,  -142,  -142,  -142,  -142,  -142,  -142,  -142,
-     -96,  -142,  -142,   139,    90,  -142,    51,  -114,    30,  -142,
-    -141,   -74,  -142,    15,  -142,  -142,  -142,   -10,    -2,  -142,
-     -30,    17,  -142,  -142,   112,  -142,   102,  -142,  -142,  -142,
-    -142,    -4,   -63
+    -144,  -144,   218,  -144,  -144,  -144,  -144,  -144,  -144,  -144,
+     -98,  -144,  -144,   136,    90,  -144,    50,  -116,    32,  -144,
+    -143,   -81,  -144,    12,  -144,  -144,  -144,   -10,     1,  -144,
+     -27,    18,  -144,  -144,   114,  -144,   104,  -144,  -144,  -144,
+    -144,    -4,   -65
 };
 
 /* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_uint8 yydefgoto[] =
 {
-       0,    18,    19,    20,    21,    22,    23,    24,   166,    25,
-      26,   217,   104,   107,   105,   137,   145,   146,   202,   180,
-     111,    85,   210,   206,   195,   207,   112,   113,   208,    51,
-      74,   155,   177,    87,    88,    52,   100,   101,   161,   191,
-     192,    53,    54
+       0,    18,    19,    20,    21,    22,    23,    24,   168,    25,
+      26,   219,   106,   109,   107,   139,   147,   148,   204,   182,
+     113,    87,   212,   208,   197,   209,   114,   115,   210,    52,
+      76,   157,   179,    89,    90,    53,   102,   103,   163,   193,
+     194,    54,    55
 };
 
 /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
@@ -787,56 +788,58 @@ static const yytype_uint8 yydefgoto[] =
    number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      49,    37,   157,   125,    89,    41,   172,    84,    50,    84,
-      96,    28,    47,   115,    36,   103,   189,   106,   108,   108,
-      75,    34,    36,    94,    38,   190,    59,   127,    99,    61,
-      62,    63,   196,   197,    64,    65,    39,   133,   134,   135,
-     136,   175,    42,    43,    44,    45,    46,   114,    29,   126,
-     131,    89,   132,   205,    79,    40,    35,   185,    90,    91,
-      92,    93,    95,   148,   214,   215,    97,   123,   124,   106,
-      55,   219,    56,   102,    98,    60,   169,   186,   188,    57,
-      58,     1,     2,    47,     3,    66,     4,     5,     6,    10,
-      67,     7,  -116,     8,    48,   149,   150,   151,   138,   221,
-     139,    68,    42,    43,    44,    45,    46,   152,   128,   129,
-     130,   153,   154,     9,   140,    10,   139,   141,   142,   143,
-     144,   170,   102,   171,   162,    11,    12,    13,    14,    15,
-      16,     2,   200,     3,   171,     4,     5,     6,    69,    30,
-       7,    17,     8,    47,    70,   176,    71,    72,    31,    73,
-      77,   149,   150,   151,   141,   142,   143,   144,    76,   181,
-     182,    32,     9,   152,    10,    80,    78,   153,   154,    47,
-     141,   142,   143,   144,    33,   174,    13,    14,    15,    16,
-      81,    82,   203,   203,    83,    84,    86,    47,   110,   116,
-     117,   118,   119,    10,   147,   120,   121,   122,   160,   158,
-     165,   218,   163,   164,   168,   173,   178,   179,   184,   183,
-     193,   194,   198,   209,   199,   222,   201,   212,    27,   211,
-     216,   109,   167,   204,   187,   213,   156,   220,   159
+      50,    38,   159,   127,    91,    42,   174,    28,   117,    10,
+      98,    51,    86,    37,    86,   105,   191,   108,   110,   110,
+      37,    35,   129,    48,    77,   192,   101,    61,   198,   199,
+      63,    64,    65,    39,    96,    66,    67,   143,   144,   145,
+     146,   177,   216,   217,    29,    40,    43,    44,    45,    46,
+      47,    91,   116,   207,   128,    81,    36,   187,    56,    41,
+      92,    93,    94,    95,    97,   133,    30,   134,    99,   108,
+     150,   221,   125,   126,    57,   104,   171,   188,   190,   100,
+     151,   152,   153,     1,     2,    58,     3,    48,     4,     5,
+       6,    59,   154,     7,    60,     8,   155,   156,    49,   223,
+      62,    31,   151,   152,   153,    43,    44,    45,    46,    47,
+      32,   130,   131,   132,   154,     9,    68,    10,   155,   156,
+     140,    69,   141,    33,   104,    70,   164,    11,    12,    13,
+      14,    15,    16,     2,    71,     3,    34,     4,     5,     6,
+      72,    73,     7,    17,     8,    74,    48,   178,    48,   143,
+     144,   145,   146,  -117,   176,   135,   136,   137,   138,    75,
+      78,   183,   184,   142,     9,   141,    10,   143,   144,   145,
+     146,   172,   202,   173,   173,    79,    82,    80,    13,    14,
+      15,    16,    83,    84,   205,   205,    85,    86,    88,    48,
+     112,   118,   119,   120,   121,    10,   149,   122,   123,   124,
+     162,   160,   167,   220,   165,   170,   166,   175,   180,   181,
+     185,   186,   195,   196,   200,   201,   214,   211,   203,    27,
+     111,   213,   218,   224,   169,   189,   222,   206,   215,     0,
+     158,     0,   161
 };
 
-static const yytype_uint8 yycheck[] =
+static const yytype_int16 yycheck[] =
 {
-      10,     5,   116,    99,    67,     9,   147,    33,    10,    33,
-      73,     5,    64,    87,    64,    78,     9,    80,    81,    82,
-      50,     7,    64,    75,    11,    18,    30,   101,    70,    33,
-      34,    35,    57,    58,    38,    39,    14,    38,    39,    40,
-      41,   155,    23,    24,    25,    26,    27,    73,    42,    73,
-      71,   114,    73,   194,    58,    16,    42,   171,    68,    69,
-      70,    71,    72,    28,    31,    32,    76,    97,    98,   132,
-       0,   212,    69,    77,    76,    64,   139,   173,   174,    69,
-      14,     3,     4,    64,     6,    64,     8,     9,    10,    37,
-      36,    13,    74,    15,    75,    60,    61,    62,    71,   213,
-      73,    70,    23,    24,    25,    26,    27,    72,    44,    45,
-      46,    76,    77,    35,    71,    37,    73,    65,    66,    67,
-      68,    71,   126,    73,   128,    47,    48,    49,    50,    51,
-      52,     4,    71,     6,    73,     8,     9,    10,    70,     7,
-      13,    63,    15,    64,    70,   155,    70,    70,    16,    19,
-      14,    60,    61,    62,    65,    66,    67,    68,    73,   163,
-     164,    29,    35,    72,    37,    70,    74,    76,    77,    64,
-      65,    66,    67,    68,    42,    70,    49,    50,    51,    52,
-      70,    70,   192,   193,    12,    33,    64,    64,    70,    72,
-      71,    71,    71,    37,    43,    71,    71,    71,    20,    71,
-      56,   211,    44,    44,    70,    70,    22,    21,    66,    72,
-      22,    34,    71,    30,    71,    66,    71,    43,     1,    73,
-      59,    82,   132,   193,   173,   208,   114,   212,   126
+      10,     5,   118,   101,    69,     9,   149,     5,    89,    37,
+      75,    10,    33,    64,    33,    80,     9,    82,    83,    84,
+      64,     7,   103,    64,    51,    18,    70,    31,    57,    58,
+      34,    35,    36,    11,    75,    39,    40,    65,    66,    67,
+      68,   157,    31,    32,    42,    14,    23,    24,    25,    26,
+      27,   116,    73,   196,    73,    59,    42,   173,     0,    16,
+      70,    71,    72,    73,    74,    71,    64,    73,    78,   134,
+      28,   214,    99,   100,    69,    79,   141,   175,   176,    78,
+      60,    61,    62,     3,     4,    69,     6,    64,     8,     9,
+      10,    14,    72,    13,    64,    15,    76,    77,    75,   215,
+      64,     7,    60,    61,    62,    23,    24,    25,    26,    27,
+      16,    44,    45,    46,    72,    35,    64,    37,    76,    77,
+      71,    36,    73,    29,   128,    70,   130,    47,    48,    49,
+      50,    51,    52,     4,    70,     6,    42,     8,     9,    10,
+      70,    70,    13,    63,    15,    70,    64,   157,    64,    65,
+      66,    67,    68,    74,    70,    38,    39,    40,    41,    19,
+      73,   165,   166,    71,    35,    73,    37,    65,    66,    67,
+      68,    71,    71,    73,    73,    14,    70,    74,    49,    50,
+      51,    52,    70,    70,   194,   195,    12,    33,    64,    64,
+      70,    72,    71,    71,    71,    37,    43,    71,    71,    71,
+      20,    71,    56,   213,    44,    70,    44,    70,    22,    21,
+      72,    66,    22,    34,    71,    71,    43,    30,    71,     1,
+      84,    73,    59,    66,   134,   175,   214,   195,   210,    -1,
+     116,    -1,   128
 };
 
 /* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
@@ -846,26 +849,26 @@ static const yytype_int8 yystos[] =
        0,     3,     4,     6,     8,     9,    10,    13,    15,    35,
       37,    47,    48,    49,    50,    51,    52,    63,    79,    80,
       81,    82,    83,    84,    85,    87,    88,    80,     5,    42,
-       7,    16,    29,    42,     7,    42,    64,   119,    11,    14,
-      16,   119,    23,    24,    25,    26,    27,    64,    75,   105,
-     106,   107,   113,   119,   120,     0,    69,    69,    14,   119,
-      64,   119,   119,   119,   119,   119,    64,    36,    70,    70,
-      70,    70,    70,    19,   108,   108,    73,    14,    74,   119,
-      70,    70,    70,    12,    33,    99,    64,   111,   112,   120,
-     105,   105,   105,   105,    75,   105,   120,   105,   106,    70,
-     114,   115,   119,   120,    90,    92,   120,    91,   120,    91,
-      70,    98,   104,   105,    73,    99,    72,    71,    71,    71,
-      71,    71,    71,   108,   108,    88,    73,    99,    44,    45,
-      46,    71,    73,    38,    39,    40,    41,    93,    71,    73,
-      71,    65,    66,    67,    68,    94,    95,    43,    28,    60,
-      61,    62,    72,    76,    77,   109,   112,    95,    71,   114,
-      20,   116,   119,    44,    44,    56,    86,    92,    70,   120,
-      71,    73,    98,    70,    70,    95,   105,   110,    22,    21,
-      97,   119,   119,    72,    66,    95,    88,    94,    88,     9,
-      18,   117,   118,    22,    34,   102,    57,    58,    71,    71,
-      71,    71,    96,   105,    96,    98,   101,   103,   106,    30,
-     100,    73,    43,   109,    31,    32,    59,    89,   105,    98,
-     101,    95,    66
+      64,     7,    16,    29,    42,     7,    42,    64,   119,    11,
+      14,    16,   119,    23,    24,    25,    26,    27,    64,    75,
+     105,   106,   107,   113,   119,   120,     0,    69,    69,    14,
+      64,   119,    64,   119,   119,   119,   119,   119,    64,    36,
+      70,    70,    70,    70,    70,    19,   108,   108,    73,    14,
+      74,   119,    70,    70,    70,    12,    33,    99,    64,   111,
+     112,   120,   105,   105,   105,   105,    75,   105,   120,   105,
+     106,    70,   114,   115,   119,   120,    90,    92,   120,    91,
+     120,    91,    70,    98,   104,   105,    73,    99,    72,    71,
+      71,    71,    71,    71,    71,   108,   108,    88,    73,    99,
+      44,    45,    46,    71,    73,    38,    39,    40,    41,    93,
+      71,    73,    71,    65,    66,    67,    68,    94,    95,    43,
+      28,    60,    61,    62,    72,    76,    77,   109,   112,    95,
+      71,   114,    20,   116,   119,    44,    44,    56,    86,    92,
+      70,   120,    71,    73,    98,    70,    70,    95,   105,   110,
+      22,    21,    97,   119,   119,    72,    66,    95,    88,    94,
+      88,     9,    18,   117,   118,    22,    34,   102,    57,    58,
+      71,    71,    71,    71,    96,   105,    96,    98,   101,   103,
+     106,    30,   100,    73,    43,   109,    31,    32,    59,    89,
+     105,    98,   101,    95,    66
 };
 
 /* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
@@ -873,16 +876,16 @@ static const yytype_int8 yyr1[] =
 {
        0,    78,    79,    79,    79,    79,    79,    80,    80,    80,
       80,    80,    80,    80,    81,    81,    81,    81,    82,    83,
-      83,    83,    84,    85,    85,    85,    85,    85,    86,    86,
-      86,    87,    87,    87,    87,    88,    89,    89,    90,    90,
-      91,    91,    92,    93,    93,    93,    93,    94,    94,    95,
-      95,    95,    95,    95,    96,    96,    97,    97,    98,    98,
-      98,    98,    99,    99,   100,   100,   100,   101,   102,   102,
-     103,   103,   103,   103,   104,   104,   105,   105,   106,   106,
-     106,   106,   106,   106,   107,   107,   107,   107,   108,   108,
-     109,   109,   109,   109,   109,   109,   110,   110,   111,   111,
-     112,   113,   113,   114,   114,   114,   114,   114,   115,   115,
-     116,   116,   117,   118,   118,   118,   119,   120
+      83,    83,    83,    84,    85,    85,    85,    85,    85,    86,
+      86,    86,    87,    87,    87,    87,    88,    89,    89,    90,
+      90,    91,    91,    92,    93,    93,    93,    93,    94,    94,
+      95,    95,    95,    95,    95,    96,    96,    97,    97,    98,
+      98,    98,    98,    99,    99,   100,   100,   100,   101,   102,
+     102,   103,   103,   103,   103,   104,   104,   105,   105,   106,
+     106,   106,   106,   106,   106,   107,   107,   107,   107,   108,
+     108,   109,   109,   109,   109,   109,   109,   110,   110,   111,
+     111,   112,   113,   113,   114,   114,   114,   114,   114,   115,
+     115,   116,   116,   117,   118,   118,   118,   119,   120
 };
 
 /* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
@@ -890,16 +893,16 @@ static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     3,     1,     1,     1,     1,     1,     1,
        1,     1,     1,     0,     1,     1,     1,     1,     2,     2,
-       3,     3,     4,     7,     3,     2,     6,     6,     0,     3,
-       3,     7,     4,     5,     1,    10,     2,     0,     1,     3,
-       1,     3,     2,     1,     1,     4,     1,     1,     3,     1,
-       1,     1,     1,     0,     1,     3,     0,     3,     3,     5,
-       5,     5,     0,     2,     0,     2,     2,     3,     0,     2,
-       1,     1,     3,     3,     1,     3,     3,     1,     4,     4,
-       4,     4,     4,     4,     2,     2,     4,     4,     2,     0,
-       1,     1,     1,     1,     1,     1,     1,     1,     1,     3,
-       3,     1,     1,     1,     3,     3,     4,     4,     1,     3,
-       3,     0,     2,     1,     1,     0,     1,     1
+       3,     3,     3,     4,     7,     3,     2,     6,     6,     0,
+       3,     3,     7,     4,     5,     1,    10,     2,     0,     1,
+       3,     1,     3,     2,     1,     1,     4,     1,     1,     3,
+       1,     1,     1,     1,     0,     1,     3,     0,     3,     3,
+       5,     5,     5,     0,     2,     0,     2,     2,     3,     0,
+       2,     1,     1,     3,     3,     1,     3,     3,     1,     4,
+       4,     4,     4,     4,     4,     2,     2,     4,     4,     2,
+       0,     1,     1,     1,     1,     1,     1,     1,     1,     1,
+       3,     3,     1,     1,     1,     3,     3,     4,     4,     1,
+       3,     3,     0,     2,     1,     1,     0,     1,     1
 };
 
 
@@ -1755,842 +1758,855 @@ yyreduce:
   switch (yyn)
     {
   case 2: /* start: stmt ';'  */
-#line 75 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 76 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         wsdb_ast_ = (yyvsp[-1].sv_node);
         YYACCEPT;
     }
-#line 1764 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1767 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 3: /* start: EXPLAIN stmt ';'  */
-#line 81 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 82 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         wsdb_ast_ = std::make_shared<Explain>((yyvsp[-1].sv_node));
         YYACCEPT;
     }
-#line 1773 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1776 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 4: /* start: HELP  */
-#line 86 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 87 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         wsdb_ast_ = std::make_shared<Help>();
         YYACCEPT;
     }
-#line 1782 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1785 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 5: /* start: EXIT  */
-#line 91 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 92 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         wsdb_ast_ = nullptr;
         YYACCEPT;
     }
-#line 1791 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1794 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 6: /* start: T_EOF  */
-#line 96 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 97 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         wsdb_ast_ = nullptr;
         YYACCEPT;
     }
-#line 1800 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1803 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 13: /* stmt: %empty  */
-#line 109 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 110 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                   { (yyval.sv_node) = nullptr; }
-#line 1806 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1809 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 14: /* txnStmt: TXN_BEGIN  */
-#line 114 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 115 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnBegin>();
     }
-#line 1814 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1817 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 15: /* txnStmt: TXN_COMMIT  */
-#line 118 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 119 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnCommit>();
     }
-#line 1822 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1825 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 16: /* txnStmt: TXN_ABORT  */
-#line 122 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 123 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnAbort>();
     }
-#line 1830 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1833 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 17: /* txnStmt: TXN_ROLLBACK  */
-#line 126 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 127 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<TxnRollback>();
     }
-#line 1838 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1841 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 18: /* logStmt: CREATE STATIC_CHECKPOINT  */
-#line 133 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 134 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<LogStaticCheckpoint>();
     }
-#line 1846 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1849 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
   case 19: /* dbStmt: SHOW TABLES  */
-#line 139 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 140 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowTables>();
     }
-#line 1854 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1857 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 20: /* dbStmt: CREATE DATABASE IDENTIFIER  */
-#line 143 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 20: /* dbStmt: SHOW IDENTIFIER IDENTIFIER  */
+#line 144 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+    {
+        // BUFFER and STATS are matched as identifiers so that they stay usable as table and column names
+        if (strcasecmp((yyvsp[-1].sv_str).c_str(), "BUFFER") != 0 || strcasecmp((yyvsp[0].sv_str).c_str(), "STATS") != 0) {
+            yyerror(&(yyloc), "syntax error, expect SHOW BUFFER STATS");
+            YYERROR;
+        }
+        (yyval.sv_node) = std::make_shared<ShowBufferStats>();
+    }
+#line 1870 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+    break;
+
+  case 21: /* dbStmt: CREATE DATABASE IDENTIFIER  */
+#line 153 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateDatabase>((yyvsp[0].sv_str));
     }
-#line 1862 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1878 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 21: /* dbStmt: OPEN DATABASE IDENTIFIER  */
-#line 147 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 22: /* dbStmt: OPEN DATABASE IDENTIFIER  */
+#line 157 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<OpenDatabase>((yyvsp[0].sv_str));
     }
-#line 1870 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1886 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 22: /* indexStmt: SHOW INDEX FROM tbName  */
-#line 154 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 23: /* indexStmt: SHOW INDEX FROM tbName  */
+#line 164 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ShowIndexes>((yyvsp[0].sv_str));
     }
-#line 1878 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1894 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 23: /* ddl: CREATE TABLE tbName '(' fieldList ')' optStorageModel  */
-#line 160 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 24: /* ddl: CREATE TABLE tbName '(' fieldList ')' optStorageModel  */
+#line 170 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateTable>((yyvsp[-4].sv_str), (yyvsp[-2].sv_fields), (yyvsp[0].sv_storage_model));
     }
-#line 1886 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1902 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 24: /* ddl: DROP TABLE tbName  */
-#line 164 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 25: /* ddl: DROP TABLE tbName  */
+#line 174 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropTable>((yyvsp[0].sv_str));
     }
-#line 1894 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1910 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 25: /* ddl: DESC tbName  */
-#line 168 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 26: /* ddl: DESC tbName  */
+#line 178 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DescTable>((yyvsp[0].sv_str));
     }
-#line 1902 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1918 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 26: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
-#line 172 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 27: /* ddl: CREATE INDEX tbName '(' colNameList ')'  */
+#line 182 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<CreateIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1910 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1926 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 27: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
-#line 176 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 28: /* ddl: DROP INDEX tbName '(' colNameList ')'  */
+#line 186 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DropIndex>((yyvsp[-3].sv_str), (yyvsp[-1].sv_strs));
     }
-#line 1918 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1934 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 28: /* optStorageModel: %empty  */
-#line 182 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 29: /* optStorageModel: %empty  */
+#line 192 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                   { (yyval.sv_storage_model) = NARY_MODEL; }
-#line 1924 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1940 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 29: /* optStorageModel: STORAGE '=' NARY  */
-#line 184 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 30: /* optStorageModel: STORAGE '=' NARY  */
+#line 194 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     { (yyval.sv_storage_model) = NARY_MODEL; }
-#line 1930 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1946 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 30: /* optStorageModel: STORAGE '=' PAX  */
-#line 186 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 31: /* optStorageModel: STORAGE '=' PAX  */
+#line 196 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     { (yyval.sv_storage_model) = PAX_MODEL; }
-#line 1936 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1952 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 31: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
-#line 191 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 32: /* dml: INSERT INTO tbName VALUES '(' valueList ')'  */
+#line 201 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<InsertStmt>((yyvsp[-4].sv_str), (yyvsp[-1].sv_vals));
     }
-#line 1944 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1960 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 32: /* dml: DELETE FROM tbName optWhereClause  */
-#line 195 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 33: /* dml: DELETE FROM tbName optWhereClause  */
+#line 205 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<DeleteStmt>((yyvsp[-1].sv_str), (yyvsp[0].sv_conds));
     }
-#line 1952 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1968 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 33: /* dml: UPDATE tbName SET setClauses optWhereClause  */
-#line 199 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 34: /* dml: UPDATE tbName SET setClauses optWhereClause  */
+#line 209 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<UpdateStmt>((yyvsp[-3].sv_str), (yyvsp[-1].sv_set_clauses), (yyvsp[0].sv_conds));
     }
-#line 1960 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1976 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 34: /* dml: selectStmt  */
-#line 203 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 35: /* dml: selectStmt  */
+#line 213 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = (yyvsp[0].sv_sel);
     }
-#line 1968 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1984 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 35: /* selectStmt: SELECT selector FROM tableList optWhereClause opt_order_clause optGroupByClause optHavingClause optUsingJoinClause optLimit  */
-#line 210 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 36: /* selectStmt: SELECT selector FROM tableList optWhereClause opt_order_clause optGroupByClause optHavingClause optUsingJoinClause optLimit  */
+#line 220 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_sel) = std::make_shared<SelectStmt>((yyvsp[-8].sv_cols), (yyvsp[-6].sv_node_arr), (yyvsp[-5].sv_conds), (yyvsp[-4].sv_orderby), (yyvsp[-3].sv_groupby), (yyvsp[-2].sv_conds), (yyvsp[-1].sv_join_strategy), (yyvsp[0].sv_int));
     }
-#line 1976 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 1992 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 36: /* optLimit: LIMIT VALUE_INT  */
-#line 217 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 37: /* optLimit: LIMIT VALUE_INT  */
+#line 227 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_int) = (yyvsp[0].sv_int);
     }
-#line 1984 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2000 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 37: /* optLimit: %empty  */
-#line 220 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 38: /* optLimit: %empty  */
+#line 230 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                     { (yyval.sv_int) = -1; }
-#line 1990 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2006 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 38: /* fieldList: field  */
-#line 225 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 39: /* fieldList: field  */
+#line 235 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_fields) = std::vector<std::shared_ptr<Field>>{(yyvsp[0].sv_field)};
     }
-#line 1998 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2014 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 39: /* fieldList: fieldList ',' field  */
-#line 229 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 40: /* fieldList: fieldList ',' field  */
+#line 239 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_fields).push_back((yyvsp[0].sv_field));
     }
-#line 2006 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2022 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 40: /* colNameList: colName  */
-#line 236 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 41: /* colNameList: colName  */
+#line 246 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_strs) = std::vector<std::string>{(yyvsp[0].sv_str)};
     }
-#line 2014 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2030 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 41: /* colNameList: colNameList ',' colName  */
-#line 240 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 42: /* colNameList: colNameList ',' colName  */
+#line 250 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_strs).push_back((yyvsp[0].sv_str));
     }
-#line 2022 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2038 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 42: /* field: colName type  */
-#line 247 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 43: /* field: colName type  */
+#line 257 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_field) = std::make_shared<ColDef>((yyvsp[-1].sv_str), (yyvsp[0].sv_type_len));
     }
-#line 2030 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2046 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 43: /* type: INT  */
-#line 254 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 44: /* type: INT  */
+#line 264 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(TYPE_INT, sizeof(int));
     }
-#line 2038 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2054 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 44: /* type: BOOL  */
-#line 258 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 45: /* type: BOOL  */
+#line 268 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(TYPE_BOOL, sizeof(bool));
     }
-#line 2046 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2062 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 45: /* type: CHAR '(' VALUE_INT ')'  */
-#line 262 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 46: /* type: CHAR '(' VALUE_INT ')'  */
+#line 272 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(TYPE_STRING, (yyvsp[-1].sv_int));
     }
-#line 2054 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2070 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 46: /* type: FLOAT  */
-#line 266 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 47: /* type: FLOAT  */
+#line 276 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_type_len) = std::make_shared<TypeLen>(TYPE_FLOAT, sizeof(float));
     }
-#line 2062 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2078 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 47: /* valueList: value  */
-#line 273 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 48: /* valueList: value  */
+#line 283 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_vals) = std::vector<std::shared_ptr<Value>>{(yyvsp[0].sv_val)};
     }
-#line 2070 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2086 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 48: /* valueList: valueList ',' value  */
-#line 277 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 49: /* valueList: valueList ',' value  */
+#line 287 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_vals).push_back((yyvsp[0].sv_val));
     }
-#line 2078 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2094 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 49: /* value: VALUE_INT  */
-#line 284 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 50: /* value: VALUE_INT  */
+#line 294 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<IntLit>((yyvsp[0].sv_int));
     }
-#line 2086 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2102 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 50: /* value: VALUE_FLOAT  */
-#line 288 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 51: /* value: VALUE_FLOAT  */
+#line 298 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<FloatLit>((yyvsp[0].sv_float));
     }
-#line 2094 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2110 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 51: /* value: VALUE_STRING  */
-#line 292 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 52: /* value: VALUE_STRING  */
+#line 302 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<StringLit>((yyvsp[0].sv_str));
     }
-#line 2102 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2118 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 52: /* value: VALUE_BOOL  */
-#line 296 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 53: /* value: VALUE_BOOL  */
+#line 306 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<BoolLit>((yyvsp[0].sv_bool));
     }
-#line 2110 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2126 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 53: /* value: %empty  */
-#line 300 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 54: /* value: %empty  */
+#line 310 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_val) = std::make_shared<NullLit>();
     }
-#line 2118 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2134 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 54: /* colListWithoutAlias: col  */
-#line 307 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 55: /* colListWithoutAlias: col  */
+#line 317 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[0].sv_col)};
     }
-#line 2126 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2142 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 55: /* colListWithoutAlias: colListWithoutAlias ',' col  */
-#line 311 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 56: /* colListWithoutAlias: colListWithoutAlias ',' col  */
+#line 321 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[0].sv_col));
     }
-#line 2134 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2150 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 56: /* optGroupByClause: %empty  */
-#line 317 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 57: /* optGroupByClause: %empty  */
+#line 327 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 2140 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2156 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 57: /* optGroupByClause: GROUP BY colListWithoutAlias  */
-#line 319 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 58: /* optGroupByClause: GROUP BY colListWithoutAlias  */
+#line 329 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_groupby) = std::make_shared<GroupBy>((yyvsp[0].sv_cols));
     }
-#line 2148 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2164 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 58: /* condition: col op expr  */
-#line 326 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 59: /* condition: col op expr  */
+#line 336 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_expr));
     }
-#line 2156 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2172 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 59: /* condition: col op '(' selectStmt ')'  */
-#line 330 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 60: /* condition: col op '(' selectStmt ')'  */
+#line 340 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-4].sv_col), (yyvsp[-3].sv_comp_op), (yyvsp[-1].sv_sel));
     }
-#line 2164 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2180 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 60: /* condition: col IN '(' selectStmt ')'  */
-#line 334 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 61: /* condition: col IN '(' selectStmt ')'  */
+#line 344 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-4].sv_col), OP_IN, (yyvsp[-1].sv_sel));
     }
-#line 2172 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2188 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 61: /* condition: col IN '(' valueList ')'  */
-#line 338 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 62: /* condition: col IN '(' valueList ')'  */
+#line 348 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         auto arr = std::make_shared<ArrLit>((yyvsp[-1].sv_vals));
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-4].sv_col), OP_IN, arr);
     }
-#line 2181 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2197 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 62: /* optWhereClause: %empty  */
-#line 345 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 63: /* optWhereClause: %empty  */
+#line 355 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 2187 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2203 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 63: /* optWhereClause: WHERE whereClause  */
-#line 347 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 64: /* optWhereClause: WHERE whereClause  */
+#line 357 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 2195 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2211 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 64: /* optUsingJoinClause: %empty  */
-#line 353 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 65: /* optUsingJoinClause: %empty  */
+#line 363 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                   {(yyval.sv_join_strategy) = NESTED_LOOP;}
-#line 2201 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2217 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 65: /* optUsingJoinClause: USING NESTED_LOOP_JOIN  */
-#line 355 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 66: /* optUsingJoinClause: USING NESTED_LOOP_JOIN  */
+#line 365 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {   (yyval.sv_join_strategy) = NESTED_LOOP;  }
-#line 2207 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2223 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 66: /* optUsingJoinClause: USING SORT_MERGE_JOIN  */
-#line 357 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 67: /* optUsingJoinClause: USING SORT_MERGE_JOIN  */
+#line 367 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {   (yyval.sv_join_strategy) = SORT_MERGE;}
-#line 2213 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2229 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 67: /* conditionAgg: aggCol op value  */
-#line 361 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 68: /* conditionAgg: aggCol op value  */
+#line 371 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cond) = std::make_shared<BinaryExpr>((yyvsp[-2].sv_col), (yyvsp[-1].sv_comp_op), (yyvsp[0].sv_val));
     }
-#line 2221 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2237 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 68: /* optHavingClause: %empty  */
-#line 368 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 69: /* optHavingClause: %empty  */
+#line 378 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 2227 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2243 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 69: /* optHavingClause: HAVING havingClause  */
-#line 370 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 70: /* optHavingClause: HAVING havingClause  */
+#line 380 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_conds) = (yyvsp[0].sv_conds);
     }
-#line 2235 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2251 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 70: /* havingClause: condition  */
-#line 376 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 71: /* havingClause: condition  */
+#line 386 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 2243 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2259 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 71: /* havingClause: conditionAgg  */
-#line 380 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 72: /* havingClause: conditionAgg  */
+#line 390 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 2251 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2267 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 72: /* havingClause: havingClause AND condition  */
-#line 384 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 73: /* havingClause: havingClause AND condition  */
+#line 394 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 2259 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2275 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 73: /* havingClause: havingClause AND conditionAgg  */
-#line 388 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 74: /* havingClause: havingClause AND conditionAgg  */
+#line 398 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 2267 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2283 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 74: /* whereClause: condition  */
-#line 396 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 75: /* whereClause: condition  */
+#line 406 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_conds) = std::vector<std::shared_ptr<BinaryExpr>>{(yyvsp[0].sv_cond)};
     }
-#line 2275 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2291 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 75: /* whereClause: whereClause AND condition  */
-#line 400 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 76: /* whereClause: whereClause AND condition  */
+#line 410 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_conds).push_back((yyvsp[0].sv_cond));
     }
-#line 2283 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2299 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 76: /* col: tbName '.' colName  */
-#line 407 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 77: /* col: tbName '.' colName  */
+#line 417 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>((yyvsp[-2].sv_str), (yyvsp[0].sv_str));
     }
-#line 2291 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2307 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 77: /* col: colName  */
-#line 411 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 78: /* col: colName  */
+#line 421 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<Col>("", (yyvsp[0].sv_str));
     }
-#line 2299 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2315 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 78: /* aggCol: COUNT '(' col ')'  */
-#line 418 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 79: /* aggCol: COUNT '(' col ')'  */
+#line 428 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<AggCol>((yyvsp[-1].sv_col), AGG_COUNT);
     }
-#line 2307 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2323 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 79: /* aggCol: SUM '(' col ')'  */
-#line 422 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 80: /* aggCol: SUM '(' col ')'  */
+#line 432 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<AggCol>((yyvsp[-1].sv_col), AGG_SUM);
     }
-#line 2315 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2331 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 80: /* aggCol: AVG '(' col ')'  */
-#line 426 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 81: /* aggCol: AVG '(' col ')'  */
+#line 436 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<AggCol>((yyvsp[-1].sv_col), AGG_AVG);
     }
-#line 2323 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2339 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 81: /* aggCol: MAX '(' col ')'  */
-#line 430 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 82: /* aggCol: MAX '(' col ')'  */
+#line 440 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<AggCol>((yyvsp[-1].sv_col), AGG_MAX);
     }
-#line 2331 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2347 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 82: /* aggCol: MIN '(' col ')'  */
-#line 434 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 83: /* aggCol: MIN '(' col ')'  */
+#line 444 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_col) = std::make_shared<AggCol>((yyvsp[-1].sv_col), AGG_MIN);
     }
-#line 2339 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2355 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 83: /* aggCol: COUNT '(' '*' ')'  */
-#line 438 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 84: /* aggCol: COUNT '(' '*' ')'  */
+#line 448 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         auto col = std::make_shared<Col>("", "*");
         (yyval.sv_col) = std::make_shared<AggCol>(col, AGG_COUNT_STAR);
     }
-#line 2348 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2364 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 84: /* colList: col optAlias  */
-#line 446 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 85: /* colList: col optAlias  */
+#line 456 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[-1].sv_col)};
         (yyval.sv_cols)[0]->setAlias((yyvsp[0].sv_str));
     }
-#line 2357 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2373 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 85: /* colList: aggCol optAlias  */
-#line 451 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 86: /* colList: aggCol optAlias  */
+#line 461 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cols) = std::vector<std::shared_ptr<Col>>{(yyvsp[-1].sv_col)};
         (yyval.sv_cols)[0]->setAlias((yyvsp[0].sv_str));
     }
-#line 2366 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2382 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 86: /* colList: colList ',' col optAlias  */
-#line 456 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 87: /* colList: colList ',' col optAlias  */
+#line 466 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[-1].sv_col));
         (yyval.sv_cols).back()->setAlias((yyvsp[0].sv_str));
     }
-#line 2375 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2391 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 87: /* colList: colList ',' aggCol optAlias  */
-#line 461 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 88: /* colList: colList ',' aggCol optAlias  */
+#line 471 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cols).push_back((yyvsp[-1].sv_col));
         (yyval.sv_cols).back()->setAlias((yyvsp[0].sv_str));
     }
-#line 2384 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2400 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 88: /* optAlias: AS colName  */
-#line 469 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 89: /* optAlias: AS colName  */
+#line 479 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_str) = (yyvsp[0].sv_str);
     }
-#line 2392 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2408 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 89: /* optAlias: %empty  */
-#line 472 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 90: /* optAlias: %empty  */
+#line 482 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                       { (yyval.sv_str) = ""; }
-#line 2398 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2414 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 90: /* op: '='  */
-#line 477 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 91: /* op: '='  */
+#line 487 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = OP_EQ;
     }
-#line 2406 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2422 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 91: /* op: '<'  */
-#line 481 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 92: /* op: '<'  */
+#line 491 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = OP_LT;
     }
-#line 2414 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2430 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 92: /* op: '>'  */
-#line 485 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 93: /* op: '>'  */
+#line 495 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = OP_GT;
     }
-#line 2422 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2438 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 93: /* op: NEQ  */
-#line 489 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 94: /* op: NEQ  */
+#line 499 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = OP_NE;
     }
-#line 2430 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2446 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 94: /* op: LEQ  */
-#line 493 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 95: /* op: LEQ  */
+#line 503 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = OP_LE;
     }
-#line 2438 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2454 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 95: /* op: GEQ  */
-#line 497 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 96: /* op: GEQ  */
+#line 507 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_comp_op) = OP_GE;
     }
-#line 2446 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2462 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 96: /* expr: value  */
-#line 504 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 97: /* expr: value  */
+#line 514 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_val));
     }
-#line 2454 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2470 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 97: /* expr: col  */
-#line 508 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 98: /* expr: col  */
+#line 518 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_expr) = std::static_pointer_cast<Expr>((yyvsp[0].sv_col));
     }
-#line 2462 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2478 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 98: /* setClauses: setClause  */
-#line 515 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 99: /* setClauses: setClause  */
+#line 525 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses) = std::vector<std::shared_ptr<SetClause>>{(yyvsp[0].sv_set_clause)};
     }
-#line 2470 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2486 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 99: /* setClauses: setClauses ',' setClause  */
-#line 519 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 100: /* setClauses: setClauses ',' setClause  */
+#line 529 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_set_clauses).push_back((yyvsp[0].sv_set_clause));
     }
-#line 2478 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2494 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 100: /* setClause: colName '=' value  */
-#line 526 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 101: /* setClause: colName '=' value  */
+#line 536 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_set_clause) = std::make_shared<SetClause>((yyvsp[-2].sv_str), (yyvsp[0].sv_val));
     }
-#line 2486 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2502 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 101: /* selector: '*'  */
-#line 533 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 102: /* selector: '*'  */
+#line 543 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_cols) = {};
     }
-#line 2494 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2510 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 103: /* table: tbName  */
-#line 541 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 104: /* table: tbName  */
+#line 551 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<ExplicitTable>((yyvsp[0].sv_str));
     }
-#line 2502 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2518 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 104: /* table: '(' selectStmt ')'  */
-#line 545 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 105: /* table: '(' selectStmt ')'  */
+#line 555 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = (yyvsp[-1].sv_sel);
     }
-#line 2510 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2526 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 105: /* table: tbName JOIN tbName  */
-#line 549 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 106: /* table: tbName JOIN tbName  */
+#line 559 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<JoinExpr>((yyvsp[-2].sv_str), (yyvsp[0].sv_str), INNER_JOIN);
     }
-#line 2518 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2534 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 106: /* table: tbName INNER JOIN tbName  */
-#line 553 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 107: /* table: tbName INNER JOIN tbName  */
+#line 563 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<JoinExpr>((yyvsp[-3].sv_str), (yyvsp[0].sv_str), INNER_JOIN);
     }
-#line 2526 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2542 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 107: /* table: tbName OUTER JOIN tbName  */
-#line 557 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 108: /* table: tbName OUTER JOIN tbName  */
+#line 567 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node) = std::make_shared<JoinExpr>((yyvsp[-3].sv_str), (yyvsp[0].sv_str), OUTER_JOIN);
     }
-#line 2534 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2550 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 108: /* tableList: table  */
-#line 564 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 109: /* tableList: table  */
+#line 574 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node_arr) = std::vector<std::shared_ptr<TreeNode>>{(yyvsp[0].sv_node)};
     }
-#line 2542 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2558 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 109: /* tableList: tableList ',' table  */
-#line 568 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 110: /* tableList: tableList ',' table  */
+#line 578 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_node_arr).push_back((yyvsp[0].sv_node));
     }
-#line 2550 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2566 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 110: /* opt_order_clause: ORDER BY order_clause  */
-#line 575 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 111: /* opt_order_clause: ORDER BY order_clause  */
+#line 585 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_orderby) = (yyvsp[0].sv_orderby);
     }
-#line 2558 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2574 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 111: /* opt_order_clause: %empty  */
-#line 578 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 112: /* opt_order_clause: %empty  */
+#line 588 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                       { /* ignore*/ }
-#line 2564 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2580 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 112: /* order_clause: opt_asc_desc colListWithoutAlias  */
-#line 583 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 113: /* order_clause: opt_asc_desc colListWithoutAlias  */
+#line 593 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
     {
         (yyval.sv_orderby) = std::make_shared<OrderBy>((yyvsp[-1].sv_orderby_dir), (yyvsp[0].sv_cols));
     }
-#line 2572 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2588 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 113: /* opt_asc_desc: ASC  */
-#line 589 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 114: /* opt_asc_desc: ASC  */
+#line 599 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                     { (yyval.sv_orderby_dir) = OrderBy_ASC;     }
-#line 2578 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2594 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 114: /* opt_asc_desc: DESC  */
-#line 590 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 115: /* opt_asc_desc: DESC  */
+#line 600 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                     { (yyval.sv_orderby_dir) = OrderBy_DESC;    }
-#line 2584 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2600 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
-  case 115: /* opt_asc_desc: %empty  */
-#line 591 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+  case 116: /* opt_asc_desc: %empty  */
+#line 601 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
                     { (yyval.sv_orderby_dir) = OrderBy_ASC; }
-#line 2590 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2606 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
     break;
 
 
-#line 2594 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
+#line 2610 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.tab.cpp"
 
       default: break;
     }
@@ -2819,5 +2835,5 @@ yyreturnlab:
   return yyresult;
 }
 
-#line 597 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
+#line 607 "/mnt/c/Users/karen/CLionProjects/NJU_DBPractice/src/parser/yacc.y"
 
@@ -13,6 +13,7 @@ See the Mulan PSL v2 for more details. */
 #include "yacc.tab.h"
 #include <iostream>
 #include <memory>
+#include <strings.h>
 
 int yylex(YYSTYPE *yylval, YYLTYPE *yylloc);
 
@@ -139,6 +140,15 @@ dbStmt:
     {
         $$ = std::make_shared<ShowTables>();
     }
+    | SHOW IDENTIFIER IDENTIFIER
+    {
+        // BUFFER and STATS are matched as identifiers so that they stay usable as table and column names
+        if (strcasecmp($2.c_str(), "BUFFER") != 0 || strcasecmp($3.c_str(), "STATS") != 0) {
+            yyerror(&@$, "syntax error, expect SHOW BUFFER STATS");
+            YYERROR;
+        }
+        $$ = std::make_shared<ShowBufferStats>();
+    }
     | CREATE DATABASE IDENTIFIER
     {
         $$ = std::make_shared<CreateDatabase>($3);
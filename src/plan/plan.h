@@ -45,6 +45,15 @@ public:
   std::shared_ptr<AbstractPlan> logical_plan_;
 };
 
+class ShowBufferStatsPlan : public AbstractPlan
+{
+public:
+  auto ToString(int level) const -> std::string override
+  {
+    return fmt::format("{}ShowBufferStatsPlan", TAB_STR(level));
+  }
+};
+
 class CreateDBPlan : public AbstractPlan
 {
 public:
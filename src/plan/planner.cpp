@@ -37,6 +37,8 @@ std::shared_ptr<AbstractPlan> Planner::PlanAST(const std::shared_ptr<ast::TreeNo
     return std::make_shared<OpenDBPlan>(odb->db_name_);
   } else if (const auto exp = std::dynamic_pointer_cast<ast::Explain>(ast)) {
     return std::make_shared<ExplainPlan>(std::move(PlanAST(exp->stmt, db)));
+  } else if (std::dynamic_pointer_cast<ast::ShowBufferStats>(ast)) {
+    return std::make_shared<ShowBufferStatsPlan>();
   }
   if (db == nullptr) {
     WSDB_THROW(WSDB_DB_NOT_OPEN, "");
@@ -0,0 +1,83 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#ifndef WSDB_BUFFER_ACCESS_STRATEGY_H
+#define WSDB_BUFFER_ACCESS_STRATEGY_H
+
+#include <memory>
+#include <vector>
+#include "common/types.h"
+#include "common/config.h"
+#include "../../../common/micro.h"
+
+namespace wsdb {
+
+enum class BufferAccessType
+{
+  BULK_READ,   // large sequential scans, dirty ring frames are left to the flusher
+  BULK_WRITE,  // bulk inserts, dirty ring frames are written when they are recycled
+};
+
+/**
+ * A small private ring of frames for one large sequential operation. Pages the operation misses on are read into
+ * the frame the ring points at if that frame is no longer pinned, so the operation keeps recycling its own frames
+ * instead of evicting the working set of everybody else. Hits are served from the shared pool as usual.
+ *
+ * The ring is split across the shards of the pool since a frame can only hold pages of its own shard. A strategy
+ * belongs to one executor and must not be shared between threads, the rings are only touched by the buffer pool
+ * under the latch of their shard.
+ */
+class BufferAccessStrategy
+{
+  friend class BufferPoolManager;
+
+public:
+  /**
+   * @param type
+   * @param ring_size number of frames of the whole ring
+   */
+  BufferAccessStrategy(BufferAccessType type, size_t ring_size) : type_(type), ring_size_(ring_size) {}
+
+  DISABLE_COPY_MOVE_AND_ASSIGN(BufferAccessStrategy)
+
+  static auto Create(BufferAccessType type) -> std::unique_ptr<BufferAccessStrategy>
+  {
+    return std::make_unique<BufferAccessStrategy>(
+        type, type == BufferAccessType::BULK_READ ? BUFFER_RING_BULK_READ_SIZE : BUFFER_RING_BULK_WRITE_SIZE);
+  }
+
+  [[nodiscard]] auto GetType() const -> BufferAccessType { return type_; }
+
+  [[nodiscard]] auto GetRingSize() const -> size_t { return ring_size_; }
+
+private:
+  struct Ring
+  {
+    std::vector<frame_id_t> frames_;
+    size_t                  cursor_{0};
+  };
+
+  BufferAccessType  type_;
+  size_t            ring_size_;
+  std::vector<Ring> rings_;  // one per shard, sized by the buffer pool on first use
+};
+
+DEFINE_UNIQUE_PTR(BufferAccessStrategy);
+
+}  // namespace wsdb
+
+#endif  // WSDB_BUFFER_ACCESS_STRATEGY_H
@@ -19,66 +19,276 @@
 // Created by ziqi on 2024/7/17.
 //
 #include "buffer_pool_manager.h"
-#include "replacer/lru_replacer.h"
-#include "replacer/lru_k_replacer.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <exception>
+#include <new>
+#include <shared_mutex>
+#include <sys/mman.h>
 
 #include "../../../common/error.h"
 
 namespace wsdb {
 
-BufferPoolManager::BufferPoolManager(DiskManager* disk_manager, wsdb::LogManager* log_manager, size_t replacer_lru_k)
-   : disk_manager_(disk_manager), log_manager_(log_manager)
+static constexpr size_t HUGE_PAGE_SIZE = 2 * 1024 * 1024;
+
+// page copies of the flusher, aligned like the frames so that they can be written to O_DIRECT files
+struct AlignedPagesDeleter
 {
- if (REPLACER == "LRUReplacer") {
-   replacer_ = std::make_unique<LRUReplacer>();
- }
- else if (REPLACER == "LRUKReplacer") {
-   replacer_ = std::make_unique<LRUKReplacer>(replacer_lru_k);
- }
- else {
-   WSDB_FETAL("Unknown replacer: " + REPLACER);
- }
- // init free_list_
- for (frame_id_t i = 0; i < static_cast<frame_id_t>(BUFFER_POOL_SIZE); i++) {
-   free_list_.push_back(i);
+  void operator()(char* pages) const { operator delete[](pages, std::align_val_t(PAGE_SIZE)); }
+};
+using AlignedPages = std::unique_ptr<char[], AlignedPagesDeleter>;
+
+static auto ElapsedNs(std::chrono::steady_clock::time_point start) -> uint64_t
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+BufferPoolManager::BufferPoolManager(DiskManager* disk_manager, wsdb::LogManager* log_manager, size_t replacer_lru_k,
+    size_t pool_size, bool huge_pages, size_t shard_num)
+   : disk_manager_(disk_manager), log_manager_(log_manager), pool_size_(pool_size)
+{
+ WSDB_ASSERT(pool_size_ > 0, "buffer pool size must be positive");
+ AllocateFrames(huge_pages);
+ shard_num_ = std::max<size_t>(1, std::min(shard_num, pool_size_ / BUFFER_POOL_MIN_SHARD_SIZE));
+ shards_    = std::make_unique<Shard[]>(shard_num_);
+ frame_id_t first_frame = 0;
+ for (size_t i = 0; i < shard_num_; i++) {
+   auto& shard        = shards_[i];
+   shard.first_frame_ = first_frame;
+   shard.size_        = pool_size_ / shard_num_ + (i < pool_size_ % shard_num_ ? 1 : 0);
+   shard.replacer_    = Replacer::Create(REPLACER, shard.size_, replacer_lru_k);
+   // init free_list_
+   for (size_t j = 0; j < shard.size_; j++) {
+     shard.free_list_.push_back(first_frame++);
+   }
  }
+ flusher_ = std::thread([this] { FlushWorker(); });
 }
 
-auto BufferPoolManager::FetchPage(file_id_t fid, page_id_t pid) -> Page* {
+BufferPoolManager::~BufferPoolManager()
+{
+  {
+    std::unique_lock lock(readahead_latch_);
+    readahead_done_cv_.wait(lock, [this] { return readahead_pending_ == 0; });
+  }
+  {
+    std::scoped_lock lock(flusher_latch_);
+    stop_flusher_ = true;
+  }
+  flusher_cv_.notify_one();
+  flusher_.join();
+  munmap(pool_data_, pool_data_size_);
+}
+
+auto BufferPoolManager::FetchPage(file_id_t fid, page_id_t pid, BufferAccessStrategy* strategy) -> Page* {
   // WSDB_STUDENT_TODO(l1, t2);
 
-  std::scoped_lock lock(latch_); // 自动管理锁的获取和释放，确保线程安全
+  return FetchFrame(fid, pid, strategy)->GetPage();
+}
+
+auto BufferPoolManager::FetchPageRead(file_id_t fid, page_id_t pid, BufferAccessStrategy* strategy) -> ReadPageGuard
+{
+  return {this, FetchFrame(fid, pid, strategy)};
+}
+
+auto BufferPoolManager::FetchPageWrite(file_id_t fid, page_id_t pid, BufferAccessStrategy* strategy) -> WritePageGuard
+{
+  return {this, FetchFrame(fid, pid, strategy)};
+}
+
+auto BufferPoolManager::FetchFrame(file_id_t fid, page_id_t pid, BufferAccessStrategy* strategy) -> Frame*
+{
+  auto             start = std::chrono::steady_clock::now();
+  auto&            shard = GetShard(fid, pid);
+  std::unique_lock lock(shard.latch_); // 自动管理锁的获取和释放，确保线程安全
+  BufferPoolStats::Add(stats_.latch_wait_ns_, ElapsedNs(start));
 
   fid_pid_t page_key {fid, pid}; // 在哈希表中查找页面
-  // 页面在buffer pool中
-  if (auto iter = page_frame_lookup_.find(page_key); iter != page_frame_lookup_.end())
+  Frame*    fetched = nullptr;
+  bool      hit     = false;
+  bool      on_mark = false;
+  while (true)
+  {
+    // the frame of the page is reserved but the read-ahead has not filled it yet
+    if (IsReading(shard, fid, pid))
+    {
+      shard.flush_done_cv_.wait(lock);
+      continue;
+    }
+    // 页面在buffer pool中
+    if (auto iter = shard.page_frame_lookup_.find(page_key); iter != shard.page_frame_lookup_.end())
+    {
+      auto& frame = frames_[iter->second]; // 找到页面框架，获取对应的框架引用
+      frame.Pin(); // 增加页面框架的引用计数，表示该页面正在被使用
+      shard.PinFrame(iter->second); // 通知替换器页面被固定，以便替换器更新其内部状态
+      on_mark = frame.IsReadAheadMark();
+      frame.SetReadAheadMark(false);
+      fetched = &frame;
+      hit     = true;
+      BufferPoolStats::Add(stats_.hits_);
+      shard.file_stats_[fid].hits_++;
+      break;
+    }
+    // 页面不在buffer pool中, the disk copy is stale while the flusher is still writing the page
+    if (IsFlushing(shard, fid, pid))
+    {
+      shard.flush_done_cv_.wait(lock);
+      continue;
+    }
+    // a large sequential operation recycles its own ring before touching the rest of the pool
+    frame_id_t frame_id = strategy != nullptr ? GetRingFrame(shard, *strategy) : INVALID_FRAME_ID;
+    if (frame_id == INVALID_FRAME_ID)
+    {
+      // frames held by read-aheads become evictable once their reads complete
+      if (!shard.reading_pages_.empty() && shard.free_list_.empty() && shard.replacer_->Size() == 0)
+      {
+        shard.flush_done_cv_.wait(lock);
+        continue;
+      }
+      frame_id = GetAvailableFrame(shard); // 获取一个可用的页面框架
+      // every evictable frame holds a page the flusher is writing
+      if (frame_id == INVALID_FRAME_ID)
+      {
+        shard.flush_done_cv_.wait(lock);
+        continue;
+      }
+    }
+    // eviction has to write inline, let the flusher catch up
+    if (frames_[frame_id].IsDirty())
+    {
+      RequestFlush();
+    }
+    UpdateFrame(shard, lock, frame_id, fid, pid); // 更新页面框架的内容
+    if (strategy != nullptr)
+    {
+      RecordRingFrame(shard, *strategy, frame_id);
+    }
+    fetched = &frames_[frame_id];
+    BufferPoolStats::Add(stats_.misses_);
+    shard.file_stats_[fid].misses_++;
+    break;
+  }
+  // read-ahead latches the shards of the following pages
+  lock.unlock();
+  (hit ? stats_.hit_latency_ : stats_.miss_latency_).Record(ElapsedNs(start));
+  // bulk writes mostly fetch new pages, there is nothing to read ahead
+  if ((!hit || on_mark) && (strategy == nullptr || strategy->GetType() != BufferAccessType::BULK_WRITE))
   {
-    auto& frame = frames_[iter->second]; // 找到页面框架，获取对应的框架引用
-    frame.Pin(); // 增加页面框架的引用计数，表示该页面正在被使用
-    replacer_->Pin(iter->second); // 通知替换器页面被固定，以便替换器更新其内部状态
-    return frame.GetPage();
+    ReadAhead(fid, pid, on_mark, strategy);
   }
-  // 页面不在buffer pool中
-  frame_id_t frame_id = GetAvailableFrame(); // 获取一个可用的页面框架
-  UpdateFrame(frame_id, fid, pid); // 更新页面框架的内容
-  return frames_[frame_id].GetPage();
+  return fetched;
+}
+
+void BufferPoolManager::Prefetch(file_id_t fid, page_id_t first_pid, size_t count, BufferAccessStrategy* strategy)
+{
+  if (count == 0)
+  {
+    return;
+  }
+  {
+    // an explicit hint counts as sequential access, a miss right after the range starts the next window
+    std::scoped_lock lock(readahead_latch_);
+    auto&            state = readahead_states_[fid];
+    state.last_pid_        = static_cast<page_id_t>(first_pid + count - 1);
+    state.run_             = std::max(state.run_, BUFFER_READAHEAD_TRIGGER - 1);
+    state.window_end_      = static_cast<page_id_t>(first_pid + count);
+    state.window_          = count;
+  }
+
+  std::vector<page_id_t>  pids;
+  std::vector<char*>      bufs;
+  std::vector<frame_id_t> frame_ids;
+  for (size_t i = 0; i < count; i++)
+  {
+    auto             pid   = static_cast<page_id_t>(first_pid + i);
+    auto&            shard = GetShard(fid, pid);
+    std::scoped_lock lock(shard.latch_);
+    // leave most of a small shard to demand fetches
+    if (shard.page_frame_lookup_.count({fid, pid}) > 0 || IsFlushing(shard, fid, pid) ||
+        shard.reading_pages_.size() >= std::max<size_t>(shard.size_ / 4, 1))
+    {
+      continue;
+    }
+    frame_id_t frame_id = strategy != nullptr ? GetRingFrame(shard, *strategy) : INVALID_FRAME_ID;
+    if (frame_id != INVALID_FRAME_ID && frames_[frame_id].IsDirty())
+    {
+      frame_id = INVALID_FRAME_ID;
+    }
+    if (frame_id == INVALID_FRAME_ID)
+    {
+      if (!shard.free_list_.empty())
+      {
+        frame_id = shard.free_list_.front();
+        shard.free_list_.pop_front();
+      }
+      else if (!shard.Victim(&frame_id))
+      {
+        continue;
+      }
+      else if (auto* page = frames_[frame_id].GetPage();
+               frames_[frame_id].IsDirty() || IsFlushing(shard, page->GetFileId(), page->GetPageId()))
+      {
+        // read-ahead is only a guess and never writes, the pool is short of clean frames so stop here
+        shard.ReinstateFrame(frame_id);
+        RequestFlush();
+        break;
+      }
+    }
+    BindFrame(shard, frame_id, fid, pid);
+    if (strategy != nullptr)
+    {
+      RecordRingFrame(shard, *strategy, frame_id);
+    }
+    frames_[frame_id].SetReadAheadMark(pids.empty());
+    shard.reading_pages_.insert({fid, pid});
+    BufferPoolStats::Add(stats_.readahead_pages_);
+    shard.file_stats_[fid].readahead_pages_++;
+    pids.push_back(pid);
+    bufs.push_back(frames_[frame_id].GetPage()->GetData());
+    frame_ids.push_back(frame_id);
+  }
+  if (pids.empty())
+  {
+    return;
+  }
+
+  {
+    std::scoped_lock lock(readahead_latch_);
+    readahead_pending_++;
+  }
+  disk_manager_->ReadPagesAsync(fid, pids, bufs, [this, fid, pids, frame_ids = std::move(frame_ids)](bool ok) {
+    FinishReadAhead(fid, pids, frame_ids, ok);
+  });
+}
+
+void BufferPoolManager::SetReadAheadLimit(file_id_t fid, size_t page_num)
+{
+  std::scoped_lock lock(readahead_latch_);
+  readahead_states_[fid].page_num_ = page_num;
 }
 
 auto BufferPoolManager::UnpinPage(file_id_t fid, page_id_t pid, bool is_dirty) -> bool {
   // WSDB_STUDENT_TODO(l1, t2);
 
-  std::scoped_lock lock(latch_);
+  auto&            shard = GetShard(fid, pid);
+  std::scoped_lock lock(shard.latch_);
 
-  if (Frame* frame = GetFrame(fid, pid); frame && frame->GetPinCount() > 0) // 页面框架存在且引用计数大于0
+  if (Frame* frame = FindFrame(shard, fid, pid); frame && frame->GetPinCount() > 0) // 页面框架存在且引用计数大于0
   {
     frame->Unpin(); // 减少引用计数
+    // write-back: the page is only marked dirty here, it is written when evicted, flushed or deleted
     if (is_dirty)
     {
-      frame->SetDirty(true);
-      disk_manager_->WritePage(fid, pid, frame->GetPage()->GetData()); // 写回磁盘
+      SetFrameDirty(shard, static_cast<frame_id_t>(frame - frames_.get()), true);
+    }
+    // 最后一个使用者解除固定后，页面框架才可以被替换
+    if (!frame->InUse())
+    {
+      shard.UnpinFrame(static_cast<frame_id_t>(frame - frames_.get()));
     }
-    // 通知替换器页面已解除固定
-    replacer_->Unpin(static_cast<frame_id_t>(frame - frames_.data()));
     return true;
   }
   return false;
@@ -87,10 +297,12 @@ auto BufferPoolManager::UnpinPage(file_id_t fid, page_id_t pid, bool is_dirty) -
 auto BufferPoolManager::DeletePage(file_id_t fid, page_id_t pid) -> bool {
   // WSDB_STUDENT_TODO(l1, t2);
 
-  std::scoped_lock lock(latch_);
+  auto&            shard = GetShard(fid, pid);
+  std::unique_lock lock(shard.latch_);
+  WaitForIO(shard, lock, [fid, pid](const fid_pid_t& key) { return key.fid == fid && key.pid == pid; });
 
-  auto it = page_frame_lookup_.find({fid, pid});
-  if (it == page_frame_lookup_.end() || frames_[it->second].GetPinCount() > 0)
+  auto it = shard.page_frame_lookup_.find({fid, pid});
+  if (it == shard.page_frame_lookup_.end() || frames_[it->second].GetPinCount() > 0)
   {
     return false;
   }
@@ -99,45 +311,57 @@ auto BufferPoolManager::DeletePage(file_id_t fid, page_id_t pid) -> bool {
   if (frame.IsDirty())
   {
     disk_manager_->WritePage(fid, pid, frame.GetPage()->GetData());
+    CountWrite(fid, pid);
   }
-  frame.Reset();  // 重置页面框架，清除其状态
-  free_list_.push_back(it->second); // 将页面框架编号添加到自由列表中，表示该框架现在可用
-  replacer_->Unpin(it->second); // 通知替换器该页面框架已被删除
-  page_frame_lookup_.erase(it); // 从哈希表中删除对应的页面框架条目
+  ReleaseFrame(shard, it->second);
   return true;
 }
 
 auto BufferPoolManager::DeleteAllPages(file_id_t fid) -> bool {
   // WSDB_STUDENT_TODO(l1, t2);
 
-  std::scoped_lock lock(latch_);
-
-  bool all_pages_deleted = true;
+  // the file is usually closed right after, so no write of the flusher may still be pending on it
+  auto locks = LatchAllShards(fid);
 
-  for (auto iter = page_frame_lookup_.begin(); iter != page_frame_lookup_.end();)
+  bool                    all_pages_deleted = true;
+  std::vector<frame_id_t> dirty_frames;
+  std::vector<std::pair<Shard*, frame_id_t>> victims;
+  for (size_t i = 0; i < shard_num_; i++)
   {
-    if (iter->first.fid == fid)
+    auto& shard   = shards_[i];
+    auto  file_it = shard.file_frames_.find(fid);
+    if (file_it == shard.file_frames_.end())
     {
-      auto& frame = frames_[iter->second];
-      if (frame.GetPinCount() > 0)
+      continue;
+    }
+    for (auto frame_id : file_it->second)
+    {
+      if (frames_[frame_id].GetPinCount() > 0)
       {
         all_pages_deleted = false;
-        ++iter;
         continue;
       }
-      if (frame.IsDirty())
+      victims.emplace_back(&shard, frame_id);
+      if (frames_[frame_id].IsDirty())
       {
-        disk_manager_->WritePage(fid, iter->first.pid, frame.GetPage()->GetData());
+        dirty_frames.push_back(frame_id);
       }
-      frame.Reset();
-      free_list_.push_back(iter->second);
-      replacer_->Unpin(iter->second);
-      iter = page_frame_lookup_.erase(iter);
     }
-    else
+  }
+  WriteFrames(fid, std::move(dirty_frames));
+  for (auto [shard, frame_id] : victims)
+  {
+    ReleaseFrame(*shard, frame_id);
+  }
+  if (all_pages_deleted)
+  {
+    for (size_t i = 0; i < shard_num_; i++)
     {
-      ++iter;
+      shards_[i].file_stats_.erase(fid);
     }
+    // the file id may be reused by a file of another length
+    std::scoped_lock lock(readahead_latch_);
+    readahead_states_.erase(fid);
   }
 
   return all_pages_deleted;
@@ -146,100 +370,738 @@ auto BufferPoolManager::DeleteAllPages(file_id_t fid) -> bool {
 auto BufferPoolManager::FlushPage(file_id_t fid, page_id_t pid) -> bool {
   // WSDB_STUDENT_TODO(l1, t2);
 
-  std::scoped_lock lock(latch_);
+  auto&            shard = GetShard(fid, pid);
+  std::unique_lock lock(shard.latch_);
+  WaitForIO(shard, lock, [fid, pid](const fid_pid_t& key) { return key.fid == fid && key.pid == pid; });
 
-  if (Frame* frame = GetFrame(fid, pid); frame)
+  Frame* frame = FindFrame(shard, fid, pid);
+  if (frame == nullptr)
   {
-    if (frame->IsDirty())
-    {
-      disk_manager_->WritePage(fid, pid, frame->GetPage()->GetData());
-      frame->SetDirty(false);
-    }
-    return true;
+    return false;
   }
-  return false;
+  if (frame->IsDirty())
+  {
+    auto frame_id = static_cast<frame_id_t>(frame - frames_.get());
+    ReserveFlush(shard, frame_id);
+    // the copy waits for writers of the page, which need the shard latch to unpin it
+    lock.unlock();
+    FlushFrames(fid, {frame_id});
+  }
+  return true;
 }
 
 auto BufferPoolManager::FlushAllPages(file_id_t fid) -> bool {
   // WSDB_STUDENT_TODO(l1, t2);
 
-  std::scoped_lock lock(latch_);
-
-  for (const auto& entry : page_frame_lookup_)
+  std::vector<frame_id_t> dirty_frames;
   {
-    if (entry.first.fid == fid)
+    auto locks = LatchAllShards(fid);
+    for (size_t i = 0; i < shard_num_; i++)
     {
-      auto& frame = frames_[entry.second];
-      if (frame.IsDirty())
+      auto& shard = shards_[i];
+      if (auto file_it = shard.file_frames_.find(fid); file_it != shard.file_frames_.end())
       {
-        disk_manager_->WritePage(fid, entry.first.pid, frame.GetPage()->GetData());
-        frame.SetDirty(false);
+        for (auto frame_id : file_it->second)
+        {
+          if (frames_[frame_id].IsDirty())
+          {
+            ReserveFlush(shard, frame_id);
+            dirty_frames.push_back(frame_id);
+          }
+        }
       }
     }
   }
+  FlushFrames(fid, std::move(dirty_frames));
   return true;
 }
 
-auto BufferPoolManager::GetAvailableFrame() -> frame_id_t {
+auto BufferPoolManager::GetAvailableFrame(Shard& shard) -> frame_id_t {
   // WSDB_STUDENT_TODO(l1, t2);
 
   // 列表不为空：直接从自由列表中获取框架
-  if (!free_list_.empty())
+  if (!shard.free_list_.empty())
   {
-    frame_id_t frame_id = free_list_.front();
-    free_list_.pop_front();
+    frame_id_t frame_id = shard.free_list_.front();
+    shard.free_list_.pop_front();
     return frame_id;
   }
   // 列表为空：从替换器中选择一个牺牲的页面框架
-  frame_id_t victim_frame_id;
-  // 调用替换器的 Victim 方法，请求一个牺牲的页面框架编号
-  if (replacer_->Victim(&victim_frame_id))
+  frame_id_t              victim_frame_id = INVALID_FRAME_ID;
+  frame_id_t              frame_id;
+  std::vector<frame_id_t> flushing;
+  // 调用替换器的 Victim 方法，请求一个牺牲的页面框架编号, the dirty victim is written back by UpdateFrame
+  while (shard.Victim(&frame_id))
   {
-    for (const auto& entry : page_frame_lookup_)
+    // the flusher marked the page clean when it copied it, the update is lost if the write fails after the
+    // frame is reused, so pages being flushed stay cached until the write is done
+    auto* page = frames_[frame_id].GetPage();
+    if (!IsFlushing(shard, page->GetFileId(), page->GetPageId()))
     {
-      if (entry.second == victim_frame_id)
-      {
-        auto& frame = frames_[victim_frame_id];
-        if (frame.IsDirty())
-        {
-          disk_manager_->WritePage(entry.first.fid, entry.first.pid, frame.GetPage()->GetData());
-        }
-        page_frame_lookup_.erase(entry.first);
-        return victim_frame_id;  // 返回牺牲的页面框架编号
-      }
+      victim_frame_id = frame_id;
+      break;
     }
+    flushing.push_back(frame_id);
+  }
+  // the skipped victims were not accessed, they go back to where the replacer had them
+  for (auto flushing_id : flushing)
+  {
+    shard.ReinstateFrame(flushing_id);
+  }
+  if (victim_frame_id != INVALID_FRAME_ID)
+  {
+    return victim_frame_id;  // 返回牺牲的页面框架编号
+  }
+  if (!flushing.empty())
+  {
+    return INVALID_FRAME_ID;
   }
 
   WSDB_THROW(WSDB_NO_FREE_FRAME, "NO FREE FRAME!");
 }
 
-void BufferPoolManager::UpdateFrame(frame_id_t frame_id, file_id_t fid, page_id_t pid) {
+auto BufferPoolManager::GetRingFrame(Shard& shard, BufferAccessStrategy& strategy) -> frame_id_t
+{
+  auto& ring     = GetRing(shard, strategy);
+  auto  frame_id = ring.frames_[ring.cursor_];
+  if (frame_id == INVALID_FRAME_ID)
+  {
+    return INVALID_FRAME_ID;
+  }
+  // the frame may have been released or picked up by someone else since the strategy used it
+  auto& frame = frames_[frame_id];
+  auto* page  = frame.GetPage();
+  if (frame.InUse() || page->GetFileId() == INVALID_FILE_ID || IsReading(shard, page->GetFileId(), page->GetPageId()))
+  {
+    return INVALID_FRAME_ID;
+  }
+  // a scan should not pay for writing pages it did not dirty, and a page being flushed must stay cached until
+  // its write is done
+  if ((frame.IsDirty() && strategy.type_ == BufferAccessType::BULK_READ) ||
+      IsFlushing(shard, page->GetFileId(), page->GetPageId()))
+  {
+    return INVALID_FRAME_ID;
+  }
+  // UpdateFrame pins it in the replacer before the latch is released
+  return frame_id;
+}
+
+void BufferPoolManager::RecordRingFrame(Shard& shard, BufferAccessStrategy& strategy, frame_id_t frame_id)
+{
+  auto& ring                 = GetRing(shard, strategy);
+  ring.frames_[ring.cursor_] = frame_id;
+  ring.cursor_               = (ring.cursor_ + 1) % ring.frames_.size();
+}
+
+auto BufferPoolManager::GetRing(Shard& shard, BufferAccessStrategy& strategy) -> BufferAccessStrategy::Ring&
+{
+  if (strategy.rings_.empty())
+  {
+    strategy.rings_.resize(shard_num_);
+  }
+  auto& ring = strategy.rings_[&shard - shards_.get()];
+  if (ring.frames_.empty())
+  {
+    ring.frames_.assign(GetRingSize(shard, strategy), INVALID_FRAME_ID);
+  }
+  return ring;
+}
+
+auto BufferPoolManager::GetRingSize(const Shard& shard, const BufferAccessStrategy& strategy) const -> size_t
+{
+  return std::max<size_t>(std::min((strategy.ring_size_ + shard_num_ - 1) / shard_num_, shard.size_ / 8), 1);
+}
+
+void BufferPoolManager::UpdateFrame(
+    Shard& shard, std::unique_lock<std::mutex>& lock, frame_id_t frame_id, file_id_t fid, page_id_t pid) {
   // WSDB_STUDENT_TODO(l1, t2);
 
+  auto&     frame = frames_[frame_id];
+  fid_pid_t prev_key{frame.GetPage()->GetFileId(), frame.GetPage()->GetPageId()};
+  bool      dirty = frame.IsDirty();
+  // the frame still holds the dirty victim, fetches of it wait as if the flusher was writing it
+  if (dirty)
+  {
+    shard.flushing_pages_.insert(prev_key);
+  }
+  BindFrame(shard, frame_id, fid, pid);
+  shard.reading_pages_.insert({fid, pid});
+  // the disk I/O runs without the latch, the frame is out of the replacer and both pages are reserved
+  lock.unlock();
+  bool written = false;
+  try
+  {
+    if (dirty)
+    {
+      disk_manager_->WritePage(prev_key.fid, prev_key.pid, frame.GetPage()->GetData());
+      written = true;
+    }
+    disk_manager_->ReadPage(fid, pid, frame.GetPage()->GetData());
+  }
+  catch (WSDBException_&)
+  {
+    lock.lock();
+    FinishUpdateFrame(shard, {fid, pid}, prev_key, dirty, written);
+    if (dirty && !written)
+    {
+      // the victim keeps its page and stays dirty, give it back to the replacer so it is written again later
+      shard.page_frame_lookup_.erase({fid, pid});
+      EraseFromFileIndex(shard, fid, frame_id);
+      frame.GetPage()->SetFilePageId(prev_key.fid, prev_key.pid);
+      SetFrameDirty(shard, frame_id, true);
+      shard.page_frame_lookup_[prev_key] = frame_id;
+      shard.file_frames_[prev_key.fid].insert(frame_id);
+      shard.UnpinFrame(frame_id);
+    }
+    else
+    {
+      // a failed or corrupt read must not stay cached, the next fetch reads the page again and gets the error
+      ReleaseFrame(shard, frame_id);
+    }
+    throw;
+  }
+  lock.lock();
+  FinishUpdateFrame(shard, {fid, pid}, prev_key, dirty, written);
+  frame.Pin();
+}
+
+void BufferPoolManager::FinishUpdateFrame(
+    Shard& shard, const fid_pid_t& key, const fid_pid_t& prev_key, bool dirty, bool written)
+{
+  shard.reading_pages_.erase(key);
+  if (dirty)
+  {
+    shard.flushing_pages_.erase(prev_key);
+  }
+  if (written)
+  {
+    CountWrite(prev_key.fid, prev_key.pid);
+    BufferPoolStats::Add(stats_.inline_writes_);
+    shard.file_stats_[prev_key.fid].inline_writes_++;
+  }
+  // the waiters recheck under the latch, which is only released after the frame is settled
+  shard.flush_done_cv_.notify_all();
+}
+
+void BufferPoolManager::BindFrame(Shard& shard, frame_id_t frame_id, file_id_t fid, page_id_t pid)
+{
   auto& frame = frames_[frame_id];
-  //auto old_fid_pid = frame.GetPage()->GetFileIdPageId();
   // 旧页面条目
   file_id_t prev_fid = frame.GetPage()->GetFileId();
   page_id_t prev_pid = frame.GetPage()->GetPageId();
+  if (prev_fid != INVALID_FILE_ID)
+  {
+    shard.page_frame_lookup_.erase({prev_fid, prev_pid});
+    EraseFromFileIndex(shard, prev_fid, frame_id);
+    BufferPoolStats::Add(stats_.evictions_);
+    shard.file_stats_[prev_fid].evictions_++;
+  }
+  // the data is overwritten by the read of the new page, a dirty victim is written back from it before that
+  SetFrameDirty(shard, frame_id, false);
+  frame.SetReadAheadMark(false);
+  frame.GetPage()->SetFilePageId(fid, pid);
+  shard.PinFrame(frame_id);
+  shard.page_frame_lookup_[{fid, pid}] = frame_id;
+  shard.file_frames_[fid].insert(frame_id);
+}
 
-  if (frame.IsDirty())
+void BufferPoolManager::ReadAhead(file_id_t fid, page_id_t pid, bool on_mark, BufferAccessStrategy* strategy)
+{
+  page_id_t first;
+  size_t    count;
+  size_t    page_num;
+  {
+    std::scoped_lock lock(readahead_latch_);
+    auto&            state = readahead_states_[fid];
+    page_num               = state.page_num_;
+    if (on_mark)
+    {
+      // the access reached the last window, read the next one while the rest of it is consumed
+      first = std::max(state.window_end_, static_cast<page_id_t>(pid + 1));
+      count = std::min(std::max(state.window_ * 2, BUFFER_READAHEAD_MIN), BUFFER_READAHEAD_MAX);
+    }
+    else
+    {
+      state.run_      = pid == state.last_pid_ + 1 ? state.run_ + 1 : 1;
+      state.last_pid_ = pid;
+      if (state.run_ == 1)
+      {
+        state.window_ = 0;
+      }
+      if (state.run_ < BUFFER_READAHEAD_TRIGGER)
+      {
+        return;
+      }
+      // sequential misses, either no window yet or the access outran it
+      first = static_cast<page_id_t>(pid + 1);
+      count = state.window_ == 0 ? BUFFER_READAHEAD_MIN : std::min(state.window_ * 2, BUFFER_READAHEAD_MAX);
+    }
+  }
+  if (strategy != nullptr)
   {
-    disk_manager_->WritePage(prev_fid, prev_pid, frame.GetPage()->GetData());
+    // a window that is not small against the ring would recycle its own pages before they are used
+    size_t ring_size = 0;
+    for (size_t i = 0; i < shard_num_; i++)
+    {
+      ring_size += GetRingSize(shards_[i], *strategy);
+    }
+    count = std::min(count, std::max<size_t>(ring_size / 4, 1));
+  }
+  // pages past the limit are new or preallocated pages the caller has yet to fetch, reading them ahead would only
+  // cache zeros, pages beyond it that are cached already are skipped by Prefetch anyway
+  if (static_cast<size_t>(first) >= page_num)
+  {
+    return;
   }
+  count = std::min(count, page_num - first);
+  Prefetch(fid, first, count, strategy);
+}
 
-  page_frame_lookup_.erase({prev_fid, prev_pid});
-  frame.Reset();
-  disk_manager_->ReadPage(fid, pid, frame.GetPage()->GetData());
-  frame.GetPage()->SetFilePageId(fid, pid);
-  frame.Pin();
-  replacer_->Pin(frame_id);
-  page_frame_lookup_[{fid, pid}] = frame_id;
+void BufferPoolManager::FinishReadAhead(
+    file_id_t fid, const std::vector<page_id_t>& pids, const std::vector<frame_id_t>& frame_ids, bool ok)
+{
+  if (!ok)
+  {
+    WSDB_LOG_ERROR(fmt::format("fid: {}, read-ahead of {} pages from page {} failed", fid, pids.size(), pids.front()));
+  }
+  for (size_t i = 0; i < pids.size(); i++)
+  {
+    auto& shard = GetShard(fid, pids[i]);
+    {
+      std::scoped_lock lock(shard.latch_);
+      shard.reading_pages_.erase({fid, pids[i]});
+      if (ok)
+      {
+        shard.UnpinFrame(frame_ids[i]);
+      }
+      else
+      {
+        // whoever fetches the page reads it again and gets the error
+        ReleaseFrame(shard, frame_ids[i]);
+      }
+    }
+    shard.flush_done_cv_.notify_all();
+  }
+  // notify under the latch, the buffer pool may be destroyed as soon as it is released
+  std::scoped_lock lock(readahead_latch_);
+  readahead_pending_--;
+  readahead_done_cv_.notify_all();
 }
 
 auto BufferPoolManager::GetFrame(file_id_t fid, page_id_t pid) -> Frame*
 {
- const auto it = page_frame_lookup_.find({ fid, pid });
- return it == page_frame_lookup_.end() ? nullptr : &frames_[it->second];
+ auto&            shard = GetShard(fid, pid);
+ std::scoped_lock lock(shard.latch_);
+ return FindFrame(shard, fid, pid);
+}
+
+auto BufferPoolManager::GetFileStats() -> std::unordered_map<file_id_t, BufferCounters>
+{
+  std::unordered_map<file_id_t, BufferCounters> file_stats;
+  for (size_t i = 0; i < shard_num_; i++)
+  {
+    std::scoped_lock lock(shards_[i].latch_);
+    for (const auto& [fid, counters] : shards_[i].file_stats_)
+    {
+      file_stats[fid] += counters;
+    }
+  }
+  return file_stats;
+}
+
+auto BufferPoolManager::GetShard(file_id_t fid, page_id_t pid) -> Shard&
+{
+  // the low bits of the hash index the buckets inside the shard, use the high bits to pick the shard
+  return shards_[(std::hash<fid_pid_t>()({fid, pid}) >> 32) % shard_num_];
+}
+
+auto BufferPoolManager::FindFrame(Shard& shard, file_id_t fid, page_id_t pid) -> Frame*
+{
+ const auto it = shard.page_frame_lookup_.find({ fid, pid });
+ return it == shard.page_frame_lookup_.end() ? nullptr : &frames_[it->second];
+}
+
+void BufferPoolManager::AllocateFrames(bool huge_pages)
+{
+  pool_data_size_ = pool_size_ * PAGE_SIZE;
+  void* data      = MAP_FAILED;
+  if (huge_pages)
+  {
+    // explicit huge pages need a reserved hugetlbfs pool and a size of whole huge pages
+    size_t huge_size = (pool_data_size_ + HUGE_PAGE_SIZE - 1) / HUGE_PAGE_SIZE * HUGE_PAGE_SIZE;
+    data = mmap(nullptr, huge_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (data != MAP_FAILED)
+    {
+      pool_data_size_ = huge_size;
+    }
+  }
+  if (data == MAP_FAILED)
+  {
+    data = mmap(nullptr, pool_data_size_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED)
+    {
+      WSDB_FETAL(fmt::format("failed to allocate {} bytes for the buffer pool", pool_data_size_));
+    }
+    if (huge_pages)
+    {
+      // fall back to transparent huge pages, it is only a hint
+      madvise(data, pool_data_size_, MADV_HUGEPAGE);
+    }
+  }
+  pool_data_ = static_cast<char*>(data);
+  frames_    = std::make_unique<Frame[]>(pool_size_);
+  for (size_t i = 0; i < pool_size_; i++)
+  {
+    frames_[i].SetData(pool_data_ + i * PAGE_SIZE);
+  }
+}
+
+void BufferPoolManager::ReleaseFrame(Shard& shard, frame_id_t frame_id)
+{
+  auto& frame = frames_[frame_id];
+  auto  fid   = frame.GetPage()->GetFileId();
+  shard.page_frame_lookup_.erase({fid, frame.GetPage()->GetPageId()}); // 从哈希表中删除对应的页面框架条目
+  EraseFromFileIndex(shard, fid, frame_id);
+  shard.dirty_frames_.erase(frame_id);
+  frame.Reset();  // 重置页面框架，清除其状态
+  shard.free_list_.push_back(frame_id); // 将页面框架编号添加到自由列表中，表示该框架现在可用
+  // a free frame must not be handed out by the replacer as well, nor carry the history of its old page
+  shard.RemoveFrame(frame_id);
+}
+
+void BufferPoolManager::EraseFromFileIndex(Shard& shard, file_id_t fid, frame_id_t frame_id)
+{
+  auto it = shard.file_frames_.find(fid);
+  if (it == shard.file_frames_.end())
+  {
+    return;
+  }
+  it->second.erase(frame_id);
+  if (it->second.empty())
+  {
+    shard.file_frames_.erase(it);
+  }
+}
+
+void BufferPoolManager::SetFrameDirty(Shard& shard, frame_id_t frame_id, bool dirty)
+{
+  frames_[frame_id].SetDirty(dirty);
+  if (dirty)
+  {
+    shard.dirty_frames_.insert(frame_id);
+  }
+  else
+  {
+    shard.dirty_frames_.erase(frame_id);
+  }
+}
+
+template <typename Pred>
+void BufferPoolManager::WaitForIO(Shard& shard, std::unique_lock<std::mutex>& lock, Pred&& pred)
+{
+  shard.flush_done_cv_.wait(lock, [&shard, &pred] {
+    return std::none_of(shard.flushing_pages_.begin(), shard.flushing_pages_.end(), pred) &&
+           std::none_of(shard.reading_pages_.begin(), shard.reading_pages_.end(), pred);
+  });
+}
+
+auto BufferPoolManager::IsFlushing(const Shard& shard, file_id_t fid, page_id_t pid) -> bool
+{
+  return !shard.flushing_pages_.empty() && shard.flushing_pages_.count({fid, pid}) > 0;
+}
+
+auto BufferPoolManager::IsReading(const Shard& shard, file_id_t fid, page_id_t pid) -> bool
+{
+  return !shard.reading_pages_.empty() && shard.reading_pages_.count({fid, pid}) > 0;
+}
+
+auto BufferPoolManager::LatchAllShards(file_id_t fid) -> std::vector<std::unique_lock<std::mutex>>
+{
+  auto of_file = [fid](const fid_pid_t& key) { return key.fid == fid; };
+  while (true)
+  {
+    // wait shard by shard without holding the others, the flusher and read-ahead completions latch the shards
+    // one at a time to finish their I/O, so waiting with other latches held could deadlock
+    for (size_t i = 0; i < shard_num_; i++)
+    {
+      std::unique_lock lock(shards_[i].latch_);
+      WaitForIO(shards_[i], lock, of_file);
+    }
+    std::vector<std::unique_lock<std::mutex>> locks;
+    bool                                      busy = false;
+    for (size_t i = 0; i < shard_num_; i++)
+    {
+      auto& shard = shards_[i];
+      locks.emplace_back(shard.latch_);
+      busy = busy || std::any_of(shard.flushing_pages_.begin(), shard.flushing_pages_.end(), of_file) ||
+             std::any_of(shard.reading_pages_.begin(), shard.reading_pages_.end(), of_file);
+    }
+    if (!busy)
+    {
+      return locks;
+    }
+  }
+}
+
+void BufferPoolManager::WriteFrames(file_id_t fid, std::vector<frame_id_t> frame_ids)
+{
+  if (frame_ids.empty())
+  {
+    return;
+  }
+  std::sort(frame_ids.begin(), frame_ids.end(), [this](frame_id_t a, frame_id_t b) {
+    return frames_[a].GetPage()->GetPageId() < frames_[b].GetPage()->GetPageId();
+  });
+  std::vector<page_id_t> pids;
+  std::vector<char*>     bufs;
+  for (auto frame_id : frame_ids)
+  {
+    pids.push_back(frames_[frame_id].GetPage()->GetPageId());
+    bufs.push_back(frames_[frame_id].GetPage()->GetData());
+  }
+  disk_manager_->WritePages(fid, pids, bufs);
+  for (size_t i = 0; i < frame_ids.size(); i++)
+  {
+    SetFrameDirty(GetShard(fid, pids[i]), frame_ids[i], false);
+  }
+  for (auto pid : pids)
+  {
+    CountWrite(fid, pid);
+  }
+}
+
+void BufferPoolManager::ReserveFlush(Shard& shard, frame_id_t frame_id)
+{
+  auto* page = frames_[frame_id].GetPage();
+  shard.flushing_pages_.insert({page->GetFileId(), page->GetPageId()});
+  SetFrameDirty(shard, frame_id, false);
+}
+
+void BufferPoolManager::FlushFrames(file_id_t fid, std::vector<frame_id_t> frame_ids)
+{
+  if (frame_ids.empty())
+  {
+    return;
+  }
+  // the reservation keeps the frames bound to their pages, so the page ids can be read without the shard latches
+  std::sort(frame_ids.begin(), frame_ids.end(), [this](frame_id_t a, frame_id_t b) {
+    return frames_[a].GetPage()->GetPageId() < frames_[b].GetPage()->GetPageId();
+  });
+  AlignedPages             copies(new (std::align_val_t(PAGE_SIZE)) char[frame_ids.size() * PAGE_SIZE]);
+  std::vector<page_id_t>   pids;
+  std::vector<char*>       bufs;
+  for (size_t i = 0; i < frame_ids.size(); i++)
+  {
+    auto& frame = frames_[frame_ids[i]];
+    char* copy  = copies.get() + i * PAGE_SIZE;
+    {
+      // a writer of the page may hold the frame, the checksum must cover the bytes that are written
+      std::shared_lock latch(frame.GetLatch());
+      memcpy(copy, frame.GetPage()->GetData(), PAGE_SIZE);
+    }
+    pids.push_back(frame.GetPage()->GetPageId());
+    bufs.push_back(copy);
+  }
+  std::exception_ptr error;
+  try
+  {
+    disk_manager_->WritePages(fid, pids, bufs);
+  }
+  catch (WSDBException_&)
+  {
+    error = std::current_exception();
+  }
+  for (size_t i = 0; i < frame_ids.size(); i++)
+  {
+    auto& shard = GetShard(fid, pids[i]);
+    {
+      std::scoped_lock lock(shard.latch_);
+      shard.flushing_pages_.erase({fid, pids[i]});
+      if (error)
+      {
+        SetFrameDirty(shard, frame_ids[i], true);
+      }
+      else
+      {
+        CountWrite(fid, pids[i]);
+      }
+    }
+    shard.flush_done_cv_.notify_all();
+  }
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+void BufferPoolManager::CountWrite(file_id_t fid, page_id_t pid)
+{
+  BufferPoolStats::Add(stats_.dirty_writes_);
+  GetShard(fid, pid).file_stats_[fid].dirty_writes_++;
+}
+
+void BufferPoolManager::RequestFlush()
+{
+  // no latch is taken, a wakeup lost in a race only delays the flusher until its next interval
+  flush_requested_.store(true, std::memory_order_relaxed);
+  flusher_cv_.notify_one();
+}
+
+void BufferPoolManager::FlushWorker()
+{
+  std::unique_lock lock(flusher_latch_);
+  auto             last_log     = std::chrono::steady_clock::now();
+  uint64_t         last_fetches = 0;
+  while (true)
+  {
+    flusher_cv_.wait_for(lock, std::chrono::milliseconds(BUFFER_FLUSH_INTERVAL_MS), [this] {
+      return stop_flusher_ || flush_requested_.load(std::memory_order_relaxed);
+    });
+    if (stop_flusher_)
+    {
+      return;
+    }
+    flush_requested_.store(false, std::memory_order_relaxed);
+    lock.unlock();
+    FlushShards();
+    if (BUFFER_STATS_LOG_INTERVAL_MS > 0 &&
+        std::chrono::steady_clock::now() - last_log >= std::chrono::milliseconds(BUFFER_STATS_LOG_INTERVAL_MS))
+    {
+      // an idle pool has nothing new to report
+      auto fetches = stats_.hits_.load(std::memory_order_relaxed) + stats_.misses_.load(std::memory_order_relaxed);
+      if (fetches != last_fetches)
+      {
+        WSDB_LOG(stats_.ToString());
+        last_fetches = fetches;
+      }
+      last_log = std::chrono::steady_clock::now();
+    }
+    lock.lock();
+  }
+}
+
+void BufferPoolManager::FlushShards()
+{
+  std::vector<AlignedPages> copies;
+  std::vector<char*>        key_copies;
+  std::vector<fid_pid_t>    keys;
+  std::vector<size_t>       key_shards;
+  for (size_t s = 0; s < shard_num_; s++)
+  {
+    auto&            shard = shards_[s];
+    const auto       size  = static_cast<double>(shard.size_);
+    const auto       low_mark  = static_cast<size_t>(std::ceil(BUFFER_FLUSH_LOW_WATERMARK * size));
+    const auto       high_mark = std::max(low_mark, static_cast<size_t>(std::ceil(BUFFER_FLUSH_HIGH_WATERMARK * size)));
+    std::scoped_lock shard_lock(shard.latch_);
+    if (shard.dirty_frames_.empty())
+    {
+      continue;
+    }
+
+    // free frames and unpinned clean frames can be reused without any write, the unpinned frames are the
+    // evictable ones of the replacer
+    size_t                  evictable_num = shard.replacer_->Size();
+    std::vector<frame_id_t> candidates;
+    for (auto i : shard.dirty_frames_)
+    {
+      auto& frame = frames_[i];
+      auto  page  = frame.GetPage();
+      if (frame.InUse())
+      {
+        continue;
+      }
+      evictable_num = evictable_num > 0 ? evictable_num - 1 : 0;
+      if (!IsFlushing(shard, page->GetFileId(), page->GetPageId()))
+      {
+        candidates.push_back(i);
+      }
+    }
+    size_t clean_num = shard.free_list_.size() + evictable_num;
+    if (clean_num >= low_mark || candidates.empty())
+    {
+      continue;
+    }
+    std::sort(candidates.begin(), candidates.end(), [this](frame_id_t a, frame_id_t b) {
+      auto pa = frames_[a].GetPage();
+      auto pb = frames_[b].GetPage();
+      return std::make_pair(pa->GetFileId(), pa->GetPageId()) < std::make_pair(pb->GetFileId(), pb->GetPageId());
+    });
+    candidates.resize(std::min(candidates.size(), high_mark - clean_num));
+
+    // copy the pages so that the frames can be used (and modified) while the copies are being written
+    copies.emplace_back(new (std::align_val_t(PAGE_SIZE)) char[candidates.size() * PAGE_SIZE]);
+    for (size_t i = 0; i < candidates.size(); i++)
+    {
+      auto& frame = frames_[candidates[i]];
+      char* copy  = copies.back().get() + i * PAGE_SIZE;
+      memcpy(copy, frame.GetPage()->GetData(), PAGE_SIZE);
+      key_copies.push_back(copy);
+      SetFrameDirty(shard, candidates[i], false);
+      keys.push_back({frame.GetPage()->GetFileId(), frame.GetPage()->GetPageId()});
+      key_shards.push_back(s);
+      shard.flushing_pages_.insert(keys.back());
+    }
+  }
+  if (keys.empty())
+  {
+    return;
+  }
+
+  // write the copies of all shards in (fid, pid) order so that adjacent pages are coalesced
+  std::vector<size_t> order(keys.size());
+  for (size_t i = 0; i < order.size(); i++)
+  {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&keys](size_t a, size_t b) {
+    return std::make_pair(keys[a].fid, keys[a].pid) < std::make_pair(keys[b].fid, keys[b].pid);
+  });
+  std::vector<bool> failed(keys.size(), false);
+  for (size_t begin = 0, end; begin < order.size(); begin = end)
+  {
+    auto                     fid = keys[order[begin]].fid;
+    std::vector<page_id_t>   pids;
+    std::vector<char*>       bufs;
+    for (end = begin; end < order.size() && keys[order[end]].fid == fid; end++)
+    {
+      pids.push_back(keys[order[end]].pid);
+      bufs.push_back(key_copies[order[end]]);
+    }
+    try
+    {
+      disk_manager_->WritePagesAsync(fid, pids, bufs).get();
+    }
+    catch (WSDBException_& e)
+    {
+      WSDB_LOG_ERROR(e.what());
+      for (size_t i = begin; i < end; i++)
+      {
+        failed[order[i]] = true;
+      }
+    }
+  }
+
+  for (size_t begin = 0, end; begin < keys.size(); begin = end)
+  {
+    auto& shard = shards_[key_shards[begin]];
+    {
+      std::scoped_lock shard_lock(shard.latch_);
+      for (end = begin; end < keys.size() && key_shards[end] == key_shards[begin]; end++)
+      {
+        // keep the page dirty so that it is written again later
+        if (auto frame = FindFrame(shard, keys[end].fid, keys[end].pid); failed[end] && frame != nullptr)
+        {
+          SetFrameDirty(shard, static_cast<frame_id_t>(frame - frames_.get()), true);
+        }
+        else if (!failed[end])
+        {
+          CountWrite(keys[end].fid, keys[end].pid);
+        }
+        shard.flushing_pages_.erase(keys[end]);
+      }
+    }
+    shard.flush_done_cv_.notify_all();
+  }
 }
 
-}  // namespace wsdb
\ No newline at end of file
+}  // namespace wsdb
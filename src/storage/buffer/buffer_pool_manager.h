@@ -25,11 +25,18 @@
 #include <list>
 #include <memory>
 #include <mutex>  // NOLINT
+#include <atomic>
+#include <condition_variable>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
-#include <array>
 #include "storage/disk/disk_manager.h"
 #include "log/log_manager.h"
 #include "replacer/replacer.h"
+#include "buffer_access_strategy.h"
+#include "buffer_pool_stats.h"
+#include "page_guard.h"
 #include "frame.h"
 #include "common/page.h"
 
@@ -49,7 +56,14 @@ struct hash<wsdb::fid_pid_t>
 {
   size_t operator()(const wsdb::fid_pid_t &fp) const
   {
-    return std::hash<table_id_t>()(fp.fid) ^ std::hash<frame_id_t>()(fp.pid);
+    // fid ^ pid collides heavily for the small sequential ids we have, mix the packed pair instead
+    auto key = (static_cast<uint64_t>(static_cast<uint32_t>(fp.fid)) << 32) | static_cast<uint32_t>(fp.pid);
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return static_cast<size_t>(key);
   }
 };
 }  // namespace std
@@ -59,27 +73,77 @@ namespace wsdb {
 class BufferPoolManager
 {
 public:
-  explicit BufferPoolManager(DiskManager *disk_manager, LogManager *log_manager = nullptr, size_t replacer_lru_k = 0);
+  /**
+   * @param disk_manager
+   * @param log_manager
+   * @param replacer_lru_k k of LRUKReplacer
+   * @param pool_size number of frames
+   * @param huge_pages back the page data with huge pages if the system allows it
+   * @param shard_num number of partitions, reduced so that every shard has at least BUFFER_POOL_MIN_SHARD_SIZE frames
+   */
+  explicit BufferPoolManager(DiskManager *disk_manager, LogManager *log_manager = nullptr, size_t replacer_lru_k = 0,
+      size_t pool_size = BUFFER_POOL_SIZE, bool huge_pages = BUFFER_POOL_HUGE_PAGES,
+      size_t shard_num = BUFFER_POOL_SHARD_NUM);
 
-  ~BufferPoolManager() = default;
+  /**
+   * Wait for pending read-aheads, stop the background flusher and release the frames, pages left dirty are written
+   * by the owners of the files on close
+   */
+  ~BufferPoolManager();
 
   DISABLE_COPY_MOVE_AND_ASSIGN(BufferPoolManager)
 
   /**
    * Fetch the requested page from disk.
-   * 1. grant the latch
+   * 1. grant the latch of the shard the page belongs to
    * 2. check if the page is in the frame
-   * 3. if the page is not in the frame, GetAvailableFrame and UpdateFrame
-   * 4. else pin the frame both in the buffer and the replacer and return the page
+   * 3. if the page is not in the frame, wait until no older copy of it is being written by the flusher,
+   *    then GetAvailableFrame and UpdateFrame
+   * 4. else wait until a pending read-ahead of the page finished, pin the frame both in the buffer and the replacer
+   *    and return the page
+   * 5. sequential misses and hits on the mark of a read-ahead window read the following pages asynchronously
+   * With a strategy, a miss reuses the next frame of the strategy's ring in the shard if it is unpinned, and
+   * the frame taken otherwise replaces that ring entry
    * @param fid file that the page belongs to
    * @param pid page id
+   * @param strategy ring of a large sequential operation, nullptr for normal accesses
    * @return the page
    */
-  auto FetchPage(file_id_t fid, page_id_t pid) -> Page *;
+  auto FetchPage(file_id_t fid, page_id_t pid, BufferAccessStrategy *strategy = nullptr) -> Page *;
+
+  /**
+   * FetchPage and take the shared latch of the page, the guard unlatches and unpins the page when it is dropped
+   */
+  auto FetchPageRead(file_id_t fid, page_id_t pid, BufferAccessStrategy *strategy = nullptr) -> ReadPageGuard;
+
+  /**
+   * FetchPage and take the exclusive latch of the page, the guard unlatches and unpins the page when it is
+   * dropped, as dirty if the page was accessed mutably
+   */
+  auto FetchPageWrite(file_id_t fid, page_id_t pid, BufferAccessStrategy *strategy = nullptr) -> WritePageGuard;
+
+  /**
+   * Read pages [first_pid, first_pid + count) of the file asynchronously into free or clean evictable frames, pages
+   * already in the buffer are skipped. Fetching a page whose read is pending blocks until it completes. Prefetching
+   * stops early rather than writing a dirty victim, and it is also the hint callers that know their access pattern
+   * use, sequential detection continues from the end of the range.
+   * @param fid
+   * @param first_pid
+   * @param count
+   * @param strategy frames are taken from the ring of the strategy if given
+   */
+  void Prefetch(file_id_t fid, page_id_t first_pid, size_t count, BufferAccessStrategy *strategy = nullptr);
+
+  /**
+   * Bound the automatic read-ahead windows of the file to the pages below page_num, the owner of the file raises
+   * it as the file grows. Files without a bound are only read ahead through Prefetch, the bound is dropped with
+   * DeleteAllPages
+   */
+  void SetReadAheadLimit(file_id_t fid, size_t page_num);
 
   /**
    * Unpin the page indicating that it can be victimized
-   * 1. grant the latch
+   * 1. grant the latch of the shard
    * 2. if the frame is not in the buffer or the frame is not in use, return false
    * 3. unpin the frame, after that if the frame is not in use, unpin the frame in the replacer
    * 4. set the frame dirty if the page is dirty
@@ -92,7 +156,7 @@ public:
 
   /**
    * Delete the page from the buffer pool
-   * 1. grant the latch
+   * 1. grant the latch of the shard
    * 2. if the page is not in the buffer, return true
    * 3. if the page is in use, return false
    * 4. flush the page to disk, reset the frame, add the frame to the free list and unpin the frame in the replacer
@@ -104,7 +168,7 @@ public:
   auto DeletePage(file_id_t fid, page_id_t pid) -> bool;
 
   /**
-   * Delete all pages belong to the file
+   * Delete all pages belong to the file, all shards are latched meanwhile
    * @param fid
    * @return true if all pages are deleted successfully
    */
@@ -112,9 +176,10 @@ public:
 
   /**
    * Flush the page to disk
-   * 1. grant the latch
+   * 1. grant the latch of the shard
    * 2. if the page is not in the buffer, return false
-   * 3. flush the page to disk if the page is dirty
+   * 3. flush the page to disk if the page is dirty, see FlushFrames
+   * The caller must not hold a guard of the page
    * @param fid
    * @param pid
    * @return true if the page is flushed successfully
@@ -122,7 +187,8 @@ public:
   auto FlushPage(file_id_t fid, page_id_t pid) -> bool;
 
   /**
-   * Flush all pages to disk
+   * Flush all pages to disk, the dirty pages are collected with all shards latched and written by FlushFrames.
+   * The caller must not hold a guard of a page of the file
    * @param fid
    * @return
    */
@@ -133,17 +199,105 @@ public:
    */
   auto GetFrame(file_id_t fid, page_id_t pid) -> Frame *;
 
+  [[nodiscard]] auto GetPoolSize() const -> size_t { return pool_size_; }
+
+  [[nodiscard]] auto GetShardNum() const -> size_t { return shard_num_; }
+
+  /**
+   * Pool-wide counters and fetch latency histograms, the counters only grow while the pool lives
+   */
+  [[nodiscard]] auto GetStats() const -> const BufferPoolStats & { return stats_; }
+
+  /**
+   * Counters of the files that have pages in the buffer or had since they were opened, the counters of a file are
+   * dropped with DeleteAllPages since file ids are reused. The shards are latched one after another, so the
+   * snapshot is not atomic across shards.
+   */
+  auto GetFileStats() -> std::unordered_map<file_id_t, BufferCounters>;
+
 private:
-  /// sub procedures used by public APIs, should not be locked by latch
+  /**
+   * A partition of the pool. Pages are assigned to shards by the hash of fid_pid_t and every shard manages
+   * a contiguous slice of the frames under its own latch, so that operations on different shards do not
+   * contend. The replacer of a shard works on frame ids local to the shard.
+   */
+  struct Shard
+  {
+    void PinFrame(frame_id_t frame_id) { replacer_->Pin(frame_id - first_frame_); }
+
+    void UnpinFrame(frame_id_t frame_id) { replacer_->Unpin(frame_id - first_frame_); }
+
+    void ReinstateFrame(frame_id_t frame_id) { replacer_->Reinstate(frame_id - first_frame_); }
+
+    void RemoveFrame(frame_id_t frame_id) { replacer_->Remove(frame_id - first_frame_); }
+
+    auto Victim(frame_id_t *frame_id) -> bool
+    {
+      if (!replacer_->Victim(frame_id)) {
+        return false;
+      }
+      *frame_id += first_frame_;
+      return true;
+    }
+
+    std::mutex                                latch_;
+    frame_id_t                                first_frame_{0};
+    size_t                                    size_{0};
+    std::unique_ptr<Replacer>                 replacer_;
+    std::list<frame_id_t>                     free_list_;
+    std::unordered_map<fid_pid_t, frame_id_t> page_frame_lookup_;
+    // frames holding pages of each file, so that per-file operations do not scan the whole shard
+    std::unordered_map<file_id_t, std::unordered_set<frame_id_t>> file_frames_;
+    // frames whose page is dirty, so that the flusher looks at them instead of the whole shard
+    std::unordered_set<frame_id_t> dirty_frames_;
+    // pages whose copies are being written by the flusher, they must not be read or written meanwhile
+    std::unordered_set<fid_pid_t> flushing_pages_;
+    // pages being read ahead, their frames are in the lookup but pinned in the replacer until the read completes
+    std::unordered_set<fid_pid_t> reading_pages_;
+    // notified when flushes or read-aheads of the shard complete
+    std::condition_variable       flush_done_cv_;
+    // per-file share of the pool statistics, counted under the latch the shard already holds
+    std::unordered_map<file_id_t, BufferCounters> file_stats_;
+  };
+
+  /**
+   * Body of FetchPage, takes the latch of the shard itself
+   * @return the pinned frame
+   */
+  auto FetchFrame(file_id_t fid, page_id_t pid, BufferAccessStrategy *strategy) -> Frame *;
+
+  /// sub procedures used by public APIs, should be called with the latch of the shard held
+
+  auto GetShard(file_id_t fid, page_id_t pid) -> Shard &;
+
+  auto FindFrame(Shard &shard, file_id_t fid, page_id_t pid) -> Frame *;
 
   /**
    * Get the available frame
    * 1. if the free list is not empty, get the frame id from the free list
-   * 2. else use the replacer to get the frame id
+   * 2. else use the replacer to get the frame id, the victim stays in page_frame_lookup_ until UpdateFrame
    * 3. if no frame can be evicted, throw WSDB_NO_FREE_FRAME
-   * @return the frame id
+   * Victims whose page is being written by the flusher are skipped
+   * @return the frame id, INVALID_FRAME_ID if only frames being flushed could be evicted
+   */
+  auto GetAvailableFrame(Shard &shard) -> frame_id_t;
+
+  /**
+   * Take the frame at the cursor of the strategy's ring in the shard out of the replacer if it can be recycled,
+   * a ring frame is skipped when it is pinned, free, being flushed or, for bulk reads, dirty
+   * @return the frame id, INVALID_FRAME_ID if the caller should get a frame as usual and record it in the ring
+   */
+  auto GetRingFrame(Shard &shard, BufferAccessStrategy &strategy) -> frame_id_t;
+
+  void RecordRingFrame(Shard &shard, BufferAccessStrategy &strategy, frame_id_t frame_id);
+
+  /**
+   * The ring of the strategy in the shard, the strategy's ring size is split evenly among the shards but a ring
+   * never takes more than an eighth of its shard
    */
-  auto GetAvailableFrame() -> frame_id_t;
+  auto GetRing(Shard &shard, BufferAccessStrategy &strategy) -> BufferAccessStrategy::Ring &;
+
+  auto GetRingSize(const Shard &shard, const BufferAccessStrategy &strategy) const -> size_t;
 
   /**
    * Update the frame
@@ -151,20 +305,146 @@ private:
    * 2. update the frame with the new page
    * 3. pin the frame in the buffer and the replacer
    * 4. update the page_frame_lookup_
+   * The write and the read run without the shard latch, the victim is kept in flushing_pages_ and the new page in
+   * reading_pages_ meanwhile, so fetches of either wait on flush_done_cv_. A failed write leaves the victim dirty in
+   * the replacer and a failed read releases the frame before the exception is rethrown
+   * @param lock the held latch of the shard, it is held again on return
    * @param frame_id the frame to update
    * @param fid the file needs to be updated to the frame
    * @param pid the page needs to be updated to the frame
    */
-  void UpdateFrame(frame_id_t frame_id, file_id_t fid, page_id_t pid);
+  void UpdateFrame(
+      Shard &shard, std::unique_lock<std::mutex> &lock, frame_id_t frame_id, file_id_t fid, page_id_t pid);
+
+  /**
+   * Drop the I/O reservations of UpdateFrame, count the write of the victim and wake up the waiting fetches
+   */
+  void FinishUpdateFrame(Shard &shard, const fid_pid_t &key, const fid_pid_t &prev_key, bool dirty, bool written);
+
+  /**
+   * Drop the old page of the frame from the lookup structures and register the frame for the new page, the frame
+   * is pinned in the replacer but its data is left for the caller to read
+   */
+  void BindFrame(Shard &shard, frame_id_t frame_id, file_id_t fid, page_id_t pid);
+
+  /**
+   * Track sequential access of the file and prefetch the next window when the access turns out sequential,
+   * the window stops at the read-ahead limit of the file
+   * @param on_mark the page was the mark of the last window, otherwise the page was a miss
+   */
+  void ReadAhead(file_id_t fid, page_id_t pid, bool on_mark, BufferAccessStrategy *strategy);
+
+  /**
+   * Completion of a read-ahead, successfully read frames become evictable and failed ones are released
+   */
+  void FinishReadAhead(
+      file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<frame_id_t> &frame_ids, bool ok);
+
+  /**
+   * Allocate pool_size_ frames and bind them to one anonymous mapping, which the kernel zero-fills lazily,
+   * with huge_pages MAP_HUGETLB is tried first and transparent huge pages are requested otherwise
+   */
+  void AllocateFrames(bool huge_pages);
+
+  /**
+   * Reset an unpinned frame and return it to the free list, the page is dropped from the lookup structures
+   */
+  void ReleaseFrame(Shard &shard, frame_id_t frame_id);
+
+  static void EraseFromFileIndex(Shard &shard, file_id_t fid, frame_id_t frame_id);
+
+  /**
+   * Set the dirty flag of the frame and track it in the dirty frames of the shard, should hold the latch of the shard
+   */
+  void SetFrameDirty(Shard &shard, frame_id_t frame_id, bool dirty);
+
+  /**
+   * Block until the flusher finished writing, and read-ahead finished reading, every page of the shard matching
+   * pred, the latch is released while waiting
+   */
+  template <typename Pred>
+  static void WaitForIO(Shard &shard, std::unique_lock<std::mutex> &lock, Pred &&pred);
+
+  static auto IsFlushing(const Shard &shard, file_id_t fid, page_id_t pid) -> bool;
+
+  static auto IsReading(const Shard &shard, file_id_t fid, page_id_t pid) -> bool;
+
+  /**
+   * Latch all shards in order once none of them is flushing or reading a page of the file
+   */
+  auto LatchAllShards(file_id_t fid) -> std::vector<std::unique_lock<std::mutex>>;
+
+  /**
+   * Write the dirty pages of unpinned frames in place, sorted by page id so that adjacent pages are written together,
+   * should hold the latches of their shards. The write is synchronous since read-ahead completions need the latches
+   */
+  void WriteFrames(file_id_t fid, std::vector<frame_id_t> frame_ids);
+
+  /**
+   * Mark the dirty page of the frame clean and keep it in flushing_pages_ until FlushFrames has written it, should
+   * hold the latch of the shard
+   */
+  void ReserveFlush(Shard &shard, frame_id_t frame_id);
+
+  /**
+   * Write the pages of frames reserved by ReserveFlush, with no shard latch held. The frames may be pinned, so each
+   * page is copied under the shared latch of its frame and the copies are checksummed and written. A failed write
+   * marks the pages dirty again before the exception is rethrown
+   */
+  void FlushFrames(file_id_t fid, std::vector<frame_id_t> frame_ids);
+
+  /**
+   * Ask the flusher to run now instead of at its next interval
+   */
+  void RequestFlush();
+
+  /**
+   * Count a page written back for the pool and its file, should hold the latch of the page's shard
+   */
+  void CountWrite(file_id_t fid, page_id_t pid);
+
+  /**
+   * Body of the background flusher. Whenever the clean evictable frames of a shard drop below
+   * BUFFER_FLUSH_LOW_WATERMARK of it, dirty unpinned pages are copied under the shard latch until
+   * BUFFER_FLUSH_HIGH_WATERMARK is reached. Only the dirty frames of a shard are looked at, a shard without any
+   * costs the flusher nothing. The copies of all shards are written together outside of the
+   * latches, so that eviction rarely has to write. The statistics are logged every BUFFER_STATS_LOG_INTERVAL_MS
+   */
+  void FlushWorker();
+
+  void FlushShards();
 
 private:
-  std::mutex                                latch_;
-  DiskManager                              *disk_manager_;
-  LogManager                               *log_manager_;
-  std::unique_ptr<Replacer>                 replacer_;
-  std::array<Frame, BUFFER_POOL_SIZE>       frames_;
-  std::list<frame_id_t>                     free_list_;
-  std::unordered_map<fid_pid_t, frame_id_t> page_frame_lookup_;
+  DiskManager             *disk_manager_;
+  LogManager              *log_manager_;
+  size_t                   pool_size_;
+  std::unique_ptr<Frame[]> frames_;
+  // page data of all frames in one page-aligned region, frame i owns [i * PAGE_SIZE, (i + 1) * PAGE_SIZE)
+  char                    *pool_data_{nullptr};
+  size_t                   pool_data_size_{0};
+  size_t                   shard_num_;
+  std::unique_ptr<Shard[]> shards_;
+  BufferPoolStats          stats_;
+
+  struct ReadAheadState
+  {
+    page_id_t last_pid_{INVALID_PAGE_ID};  // last page that missed or ended a window
+    size_t    run_{0};                     // number of consecutive sequential misses
+    page_id_t window_end_{INVALID_PAGE_ID};
+    size_t    window_{0};
+    size_t    page_num_{0};  // windows stop before this page, see SetReadAheadLimit
+  };
+
+  std::mutex                                    readahead_latch_;
+  std::unordered_map<file_id_t, ReadAheadState> readahead_states_;
+  std::condition_variable                       readahead_done_cv_;
+  size_t                                        readahead_pending_{0};  // batches in flight, guarded by readahead_latch_
+
+  std::mutex              flusher_latch_;
+  std::condition_variable flusher_cv_;
+  std::atomic<bool>       flush_requested_{false};
+  bool                    stop_flusher_{false};
+  std::thread             flusher_;
 };
 
 }  // namespace wsdb
@@ -0,0 +1,115 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#include "buffer_pool_stats.h"
+#include <algorithm>
+#include "fmt/format.h"
+
+namespace wsdb {
+
+auto BufferCounters::operator+=(const BufferCounters &rhs) -> BufferCounters &
+{
+  hits_ += rhs.hits_;
+  misses_ += rhs.misses_;
+  evictions_ += rhs.evictions_;
+  dirty_writes_ += rhs.dirty_writes_;
+  inline_writes_ += rhs.inline_writes_;
+  readahead_pages_ += rhs.readahead_pages_;
+  return *this;
+}
+
+auto BufferCounters::HitRatio() const -> double
+{
+  auto total = hits_ + misses_;
+  return total == 0 ? 0.0 : static_cast<double>(hits_) / static_cast<double>(total);
+}
+
+void LatencyHistogram::Record(uint64_t ns)
+{
+  auto bucket = ns == 0 ? 0 : static_cast<size_t>(63 - __builtin_clzll(ns));
+  buckets_[std::min(bucket, BUCKET_NUM - 1)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  total_ns_.fetch_add(ns, std::memory_order_relaxed);
+}
+
+auto LatencyHistogram::MeanNs() const -> uint64_t
+{
+  auto count = Count();
+  return count == 0 ? 0 : total_ns_.load(std::memory_order_relaxed) / count;
+}
+
+auto LatencyHistogram::PercentileNs(double p) const -> uint64_t
+{
+  auto count = Count();
+  if (count == 0) {
+    return 0;
+  }
+  auto     rank = static_cast<uint64_t>(p * static_cast<double>(count));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKET_NUM; i++) {
+    seen += buckets_[i].load(std::memory_order_relaxed);
+    if (seen > rank) {
+      return uint64_t{1} << (i + 1);
+    }
+  }
+  return uint64_t{1} << BUCKET_NUM;
+}
+
+auto LatencyHistogram::BucketsToString() const -> std::string
+{
+  std::string str;
+  for (size_t i = 0; i < BUCKET_NUM; i++) {
+    auto n = buckets_[i].load(std::memory_order_relaxed);
+    if (n == 0) {
+      continue;
+    }
+    str += fmt::format("{}<{}ns: {}", str.empty() ? "" : ", ", uint64_t{1} << (i + 1), n);
+  }
+  return str;
+}
+
+auto BufferPoolStats::Snapshot() const -> BufferCounters
+{
+  BufferCounters counters;
+  counters.hits_            = hits_.load(std::memory_order_relaxed);
+  counters.misses_          = misses_.load(std::memory_order_relaxed);
+  counters.evictions_       = evictions_.load(std::memory_order_relaxed);
+  counters.dirty_writes_    = dirty_writes_.load(std::memory_order_relaxed);
+  counters.inline_writes_   = inline_writes_.load(std::memory_order_relaxed);
+  counters.readahead_pages_ = readahead_pages_.load(std::memory_order_relaxed);
+  return counters;
+}
+
+auto BufferPoolStats::ToString() const -> std::string
+{
+  auto counters = Snapshot();
+  return fmt::format(
+      "buffer pool: hits {}, misses {}, hit ratio {:.2f}%, evictions {}, dirty writes {} ({} inline), read-ahead {}, "
+      "latch wait {}us, hit p99 <{}ns, miss p99 <{}ns",
+      counters.hits_,
+      counters.misses_,
+      counters.HitRatio() * 100,
+      counters.evictions_,
+      counters.dirty_writes_,
+      counters.inline_writes_,
+      counters.readahead_pages_,
+      latch_wait_ns_.load(std::memory_order_relaxed) / 1000,
+      hit_latency_.PercentileNs(0.99),
+      miss_latency_.PercentileNs(0.99));
+}
+
+}  // namespace wsdb
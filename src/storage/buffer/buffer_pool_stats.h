@@ -0,0 +1,105 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#ifndef WSDB_BUFFER_POOL_STATS_H
+#define WSDB_BUFFER_POOL_STATS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace wsdb {
+
+/**
+ * Plain counters of buffer pool activity, kept per file under the shard latch and used as snapshots of the pool-wide
+ * atomic counters
+ */
+struct BufferCounters
+{
+  uint64_t hits_{0};
+  uint64_t misses_{0};
+  uint64_t evictions_{0};
+  uint64_t dirty_writes_{0};   // pages written back, by eviction, flushes or the background flusher
+  uint64_t inline_writes_{0};  // dirty victims a fetch had to write before it could read its page
+  uint64_t readahead_pages_{0};
+
+  auto operator+=(const BufferCounters &rhs) -> BufferCounters &;
+
+  [[nodiscard]] auto HitRatio() const -> double;
+};
+
+/**
+ * Latency histogram with power-of-two buckets, bucket i counts samples in [2^i, 2^(i+1)) nanoseconds and the last
+ * bucket everything above. Recording is a few relaxed atomic increments, reads may observe a sample half-recorded.
+ */
+class LatencyHistogram
+{
+public:
+  static constexpr size_t BUCKET_NUM = 32;
+
+  void Record(uint64_t ns);
+
+  [[nodiscard]] auto Count() const -> uint64_t { return count_.load(std::memory_order_relaxed); }
+
+  [[nodiscard]] auto MeanNs() const -> uint64_t;
+
+  /**
+   * @return upper bound of the bucket holding the p-th percentile, in nanoseconds
+   */
+  [[nodiscard]] auto PercentileNs(double p) const -> uint64_t;
+
+  /**
+   * Non-empty buckets as "<bound: count" pairs
+   */
+  [[nodiscard]] auto BucketsToString() const -> std::string;
+
+private:
+  std::array<std::atomic<uint64_t>, BUCKET_NUM> buckets_{};
+  std::atomic<uint64_t>                         count_{0};
+  std::atomic<uint64_t>                         total_ns_{0};
+};
+
+/**
+ * Pool-wide statistics, updated with relaxed atomics so that counting never adds a latch
+ */
+class BufferPoolStats
+{
+public:
+  static void Add(std::atomic<uint64_t> &counter, uint64_t n = 1) { counter.fetch_add(n, std::memory_order_relaxed); }
+
+  [[nodiscard]] auto Snapshot() const -> BufferCounters;
+
+  /**
+   * One line summary for the periodic log
+   */
+  [[nodiscard]] auto ToString() const -> std::string;
+
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+  std::atomic<uint64_t> evictions_{0};
+  std::atomic<uint64_t> dirty_writes_{0};
+  std::atomic<uint64_t> inline_writes_{0};
+  std::atomic<uint64_t> readahead_pages_{0};
+  std::atomic<uint64_t> latch_wait_ns_{0};  // time fetches spent acquiring shard latches
+  LatencyHistogram      hit_latency_;
+  LatencyHistogram      miss_latency_;
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_BUFFER_POOL_STATS_H
@@ -22,6 +22,7 @@
 #ifndef WSDB_FRAME_H
 #define WSDB_FRAME_H
 
+#include <shared_mutex>
 #include "common/types.h"
 #include "common/config.h"
 #include "common/page.h"
@@ -35,6 +36,13 @@ public:
 
   [[nodiscard]] inline auto GetPage() -> Page * { return &page_; }
 
+  /**
+   * Reader-writer latch of the page content, taken by page guards while the frame is pinned
+   */
+  [[nodiscard]] inline auto GetLatch() -> std::shared_mutex & { return latch_; }
+
+  inline void SetData(char *data) { page_.SetData(data); }
+
   [[nodiscard]] inline auto InUse() const -> bool { return pin_count_ > 0; }
 
   [[nodiscard]] inline auto IsDirty() const -> bool { return is_dirty_; }
@@ -51,17 +59,28 @@ public:
     pin_count_--;
   }
 
+  /**
+   * The first page of a read-ahead window is marked, the next window is read once the page is accessed
+   */
+  [[nodiscard]] inline auto IsReadAheadMark() const -> bool { return readahead_mark_; }
+
+  inline void SetReadAheadMark(bool mark) { readahead_mark_ = mark; }
+
   inline void Reset()
   {
     page_.Clear();
-    is_dirty_  = false;
-    pin_count_ = 0;
+    is_dirty_       = false;
+    pin_count_      = 0;
+    readahead_mark_ = false;
   }
 
 private:
   Page page_{};
   bool is_dirty_{false};
   int  pin_count_{0};
+  bool readahead_mark_{false};
+
+  std::shared_mutex latch_;
 };
 
 #endif  // WSDB_FRAME_H
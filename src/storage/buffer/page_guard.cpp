@@ -0,0 +1,96 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#include "page_guard.h"
+#include <utility>
+#include "buffer_pool_manager.h"
+
+namespace wsdb {
+
+PageGuard::PageGuard(PageGuard &&other) noexcept
+    : bpm_(std::exchange(other.bpm_, nullptr)),
+      frame_(std::exchange(other.frame_, nullptr)),
+      file_id_(other.file_id_),
+      page_id_(other.page_id_),
+      is_dirty_(std::exchange(other.is_dirty_, false))
+{}
+
+auto PageGuard::operator=(PageGuard &&other) noexcept -> PageGuard &
+{
+  bpm_      = std::exchange(other.bpm_, nullptr);
+  frame_    = std::exchange(other.frame_, nullptr);
+  file_id_  = other.file_id_;
+  page_id_  = other.page_id_;
+  is_dirty_ = std::exchange(other.is_dirty_, false);
+  return *this;
+}
+
+void PageGuard::Unpin()
+{
+  bpm_->UnpinPage(file_id_, page_id_, is_dirty_);
+  bpm_      = nullptr;
+  frame_    = nullptr;
+  is_dirty_ = false;
+}
+
+ReadPageGuard::ReadPageGuard(BufferPoolManager *bpm, Frame *frame) : PageGuard(bpm, frame)
+{
+  frame_->GetLatch().lock_shared();
+}
+
+auto ReadPageGuard::operator=(ReadPageGuard &&other) noexcept -> ReadPageGuard &
+{
+  if (this != &other) {
+    Drop();
+    PageGuard::operator=(std::move(other));
+  }
+  return *this;
+}
+
+void ReadPageGuard::Drop()
+{
+  if (frame_ == nullptr) {
+    return;
+  }
+  frame_->GetLatch().unlock_shared();
+  Unpin();
+}
+
+WritePageGuard::WritePageGuard(BufferPoolManager *bpm, Frame *frame) : PageGuard(bpm, frame)
+{
+  frame_->GetLatch().lock();
+}
+
+auto WritePageGuard::operator=(WritePageGuard &&other) noexcept -> WritePageGuard &
+{
+  if (this != &other) {
+    Drop();
+    PageGuard::operator=(std::move(other));
+  }
+  return *this;
+}
+
+void WritePageGuard::Drop()
+{
+  if (frame_ == nullptr) {
+    return;
+  }
+  frame_->GetLatch().unlock();
+  Unpin();
+}
+
+}  // namespace wsdb
@@ -0,0 +1,136 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#ifndef WSDB_PAGE_GUARD_H
+#define WSDB_PAGE_GUARD_H
+
+#include "frame.h"
+
+namespace wsdb {
+
+class BufferPoolManager;
+
+/**
+ * Pin and latch of a fetched page, both are released when the guard is dropped or destroyed. Guards are move-only,
+ * a moved-from or dropped guard is empty. The frame latch is released before the pin so that an unpinned frame is
+ * never latched, which is what eviction and the flusher rely on.
+ */
+class PageGuard
+{
+public:
+  PageGuard() = default;
+
+  PageGuard(const PageGuard &)                     = delete;
+  auto operator=(const PageGuard &) -> PageGuard & = delete;
+
+  [[nodiscard]] auto IsValid() const -> bool { return frame_ != nullptr; }
+
+  [[nodiscard]] auto GetPageId() const -> page_id_t { return page_id_; }
+
+protected:
+  PageGuard(BufferPoolManager *bpm, Frame *frame)
+      : bpm_(bpm), frame_(frame), file_id_(frame->GetPage()->GetFileId()), page_id_(frame->GetPage()->GetPageId())
+  {}
+
+  PageGuard(PageGuard &&other) noexcept;
+
+  auto operator=(PageGuard &&other) noexcept -> PageGuard &;
+
+  ~PageGuard() = default;
+
+  /**
+   * Unpin the page, the derived guard has released the latch already
+   */
+  void Unpin();
+
+  BufferPoolManager *bpm_{nullptr};
+  Frame             *frame_{nullptr};
+  file_id_t          file_id_{INVALID_FILE_ID};
+  page_id_t          page_id_{INVALID_PAGE_ID};
+  bool               is_dirty_{false};
+};
+
+/**
+ * Shared access to a page, any number of read guards of a page can be held at the same time
+ */
+class ReadPageGuard : public PageGuard
+{
+  friend class BufferPoolManager;
+
+public:
+  ReadPageGuard() = default;
+
+  ReadPageGuard(ReadPageGuard &&other) noexcept = default;
+
+  auto operator=(ReadPageGuard &&other) noexcept -> ReadPageGuard &;
+
+  ~ReadPageGuard() { Drop(); }
+
+  [[nodiscard]] auto GetPage() const -> const Page * { return frame_->GetPage(); }
+
+  [[nodiscard]] auto GetData() const -> const char * { return frame_->GetPage()->GetData(); }
+
+  void Drop();
+
+private:
+  /**
+   * @param frame pinned frame, the shared latch is taken here
+   */
+  ReadPageGuard(BufferPoolManager *bpm, Frame *frame);
+};
+
+/**
+ * Exclusive access to a page, the page is unpinned as dirty if it was accessed mutably through the guard
+ */
+class WritePageGuard : public PageGuard
+{
+  friend class BufferPoolManager;
+
+public:
+  WritePageGuard() = default;
+
+  WritePageGuard(WritePageGuard &&other) noexcept = default;
+
+  auto operator=(WritePageGuard &&other) noexcept -> WritePageGuard &;
+
+  ~WritePageGuard() { Drop(); }
+
+  [[nodiscard]] auto GetPage() -> Page *
+  {
+    is_dirty_ = true;
+    return frame_->GetPage();
+  }
+
+  [[nodiscard]] auto GetData() -> char * { return GetPage()->GetData(); }
+
+  /**
+   * Read-only access that does not dirty the page
+   */
+  [[nodiscard]] auto GetConstPage() const -> const Page * { return frame_->GetPage(); }
+
+  void Drop();
+
+private:
+  /**
+   * @param frame pinned frame, the exclusive latch is taken here
+   */
+  WritePageGuard(BufferPoolManager *bpm, Frame *frame);
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_PAGE_GUARD_H
@@ -0,0 +1,94 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#include "clock_replacer.h"
+#include "../common/error.h"
+
+namespace wsdb {
+
+ClockReplacer::ClockReplacer(size_t max_size)
+    : states_(std::make_unique<std::atomic<uint8_t>[]>(max_size)), max_size_(max_size)
+{
+  for (size_t i = 0; i < max_size_; ++i) {
+    states_[i].store(UNTRACKED, std::memory_order_relaxed);
+  }
+}
+
+auto ClockReplacer::Victim(frame_id_t *frame_id) -> bool
+{
+  std::scoped_lock lock(latch_);
+  // the first round may only clear reference bits, the second one finds a victim if there is any
+  for (size_t step = 0; step < 2 * max_size_; ++step) {
+    auto &state = states_[hand_];
+    auto  cur   = state.load(std::memory_order_relaxed);
+    auto  pos   = hand_;
+    hand_       = (hand_ + 1) % max_size_;
+    if ((cur & EVICTABLE) == 0) {
+      continue;
+    }
+    // a concurrent Pin or Unpin wins over the sweep, the frame is looked at again in the next round
+    if ((cur & REFERENCED) != 0) {
+      state.compare_exchange_strong(cur, EVICTABLE, std::memory_order_relaxed);
+      continue;
+    }
+    if (state.compare_exchange_strong(cur, UNTRACKED, std::memory_order_relaxed)) {
+      size_.fetch_sub(1, std::memory_order_relaxed);
+      *frame_id = static_cast<frame_id_t>(pos);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ClockReplacer::Pin(frame_id_t frame_id)
+{
+  WSDB_ASSERT(static_cast<size_t>(frame_id) < max_size_, "frame id out of range");
+  // the previous state tells whether the frame leaves the evictable ones, so the count follows every transition
+  if ((states_[frame_id].exchange(PINNED | REFERENCED, std::memory_order_relaxed) & EVICTABLE) != 0) {
+    size_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+void ClockReplacer::Unpin(frame_id_t frame_id)
+{
+  WSDB_ASSERT(static_cast<size_t>(frame_id) < max_size_, "frame id out of range");
+  if ((states_[frame_id].exchange(EVICTABLE | REFERENCED, std::memory_order_relaxed) & EVICTABLE) == 0) {
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void ClockReplacer::Reinstate(frame_id_t frame_id)
+{
+  WSDB_ASSERT(static_cast<size_t>(frame_id) < max_size_, "frame id out of range");
+  // a frame pinned again since it was victimized is tracked already
+  uint8_t untracked = UNTRACKED;
+  if (states_[frame_id].compare_exchange_strong(untracked, EVICTABLE, std::memory_order_relaxed)) {
+    size_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+void ClockReplacer::Remove(frame_id_t frame_id)
+{
+  WSDB_ASSERT(static_cast<size_t>(frame_id) < max_size_, "frame id out of range");
+  if ((states_[frame_id].exchange(UNTRACKED, std::memory_order_relaxed) & EVICTABLE) != 0) {
+    size_.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+
+auto ClockReplacer::Size() -> size_t { return size_.load(std::memory_order_relaxed); }
+
+}  // namespace wsdb
@@ -0,0 +1,96 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#ifndef WSDB_CLOCK_REPLACER_H
+#define WSDB_CLOCK_REPLACER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>  // NOLINT
+#include "replacer.h"
+
+namespace wsdb {
+
+/**
+ * ClockReplacer approximates LRU with a reference bit per frame and a sweeping hand.
+ * The state of a frame is one atomic byte, so Pin and Unpin are single relaxed exchanges without any latch,
+ * only Victim takes the latch to move the hand.
+ */
+class ClockReplacer : public Replacer
+{
+public:
+  /**
+   * @param max_size number of frames of the buffer pool
+   */
+  explicit ClockReplacer(size_t max_size);
+
+  ~ClockReplacer() override = default;
+
+  /**
+   * Sweep the hand from its last position. An evictable frame with the reference bit set gets a second
+   * chance and loses the bit, the first evictable frame without it is the victim.
+   * @param frame_id
+   * @return true if a victim frame was found, false otherwise
+   */
+  auto Victim(frame_id_t *frame_id) -> bool override;
+
+  /**
+   * Mark the frame referenced and not evictable
+   * @param frame_id
+   */
+  void Pin(frame_id_t frame_id) override;
+
+  /**
+   * Mark the frame referenced and evictable
+   * @param frame_id
+   */
+  void Unpin(frame_id_t frame_id) override;
+
+  /**
+   * Mark a victimized frame evictable again, without the reference bit it had lost to the sweep
+   * @param frame_id
+   */
+  void Reinstate(frame_id_t frame_id) override;
+
+  /**
+   * Mark the frame untracked
+   * @param frame_id
+   */
+  void Remove(frame_id_t frame_id) override;
+
+  /**
+   * Number of evictable frames, kept by the transitions into and out of EVICTABLE
+   */
+  auto Size() -> size_t override;
+
+private:
+  // frame states, a frame that has never been unpinned or was victimized is untracked
+  static constexpr uint8_t UNTRACKED  = 0;
+  static constexpr uint8_t PINNED     = 1;
+  static constexpr uint8_t EVICTABLE  = 2;
+  static constexpr uint8_t REFERENCED = 4;
+
+  std::mutex                             latch_;  // protects hand_
+  std::unique_ptr<std::atomic<uint8_t>[]> states_;
+  size_t                                 hand_{0};
+  size_t                                 max_size_;
+  std::atomic<size_t>                    size_{0};  // number of evictable frames
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_CLOCK_REPLACER_H
@@ -20,21 +20,26 @@
 //
 
 #include "lru_k_replacer.h"
+#include <algorithm>
 #include "common/config.h"
 #include "../common/error.h"
 
-using ULL = unsigned long long;
-
 namespace wsdb {
 
-LRUKReplacer::LRUKReplacer(size_t k) : max_size_(BUFFER_POOL_SIZE), k_(k) {
- cur_ts_ = 0;
- cur_size_ = 0;
-}
+LRUKReplacer::LRUKReplacer(size_t k, size_t max_size)
+    : max_size_(max_size),
+      k_(std::max<size_t>(k, 1)),
+      history_(max_size * k_),
+      hist_head_(max_size, 0),
+      hist_count_(max_size, 0),
+      heap_pos_(max_size, NOT_IN_HEAP),
+      victimized_(max_size, false),
+      inf_heap_(max_size, &heap_pos_),
+      k_heap_(max_size, &heap_pos_)
+{}
 
 auto LRUKReplacer::Victim(frame_id_t* frame_id) -> bool
 {
-  // WSDB_STUDENT_TODO(l1, f1);
   std::scoped_lock lock(latch_);
 
   // 没有可用的frame
@@ -42,135 +47,171 @@ auto LRUKReplacer::Victim(frame_id_t* frame_id) -> bool
   {
     return false;
   }
+  // frames with an infinite backward k-distance go first, each heap yields the oldest access on its top
+  auto& heap = inf_heap_.Empty() ? k_heap_ : inf_heap_;
+  *frame_id  = heap.Top();
+  heap.Erase(*frame_id);
+  // the history is dropped when the frame is pinned for its next page, Reinstate still needs it
+  victimized_[*frame_id] = true;
+  cur_size_--;
+  return true;
+}
 
-  // 1. 初始化变量
-  ULL max_dist = 0; // 当前最大的“逆向K距离”
-  frame_id_t selected_frame = -1; // 被选中的frame的ID
-  timestamp_t earliest_ts = std::numeric_limits<timestamp_t>::max(); // 最早的时间戳（处理距离相同的情况）
-  bool found_candidate = false;
+void LRUKReplacer::Pin(frame_id_t frame_id)
+{
+  std::scoped_lock lock(latch_);
+  CheckFrameId(frame_id);
 
-  // 2. 查找具有最大“逆向K距离”的frame，记录候选frame
-  for (frame_id_t i = 0; i < static_cast<frame_id_t>(max_size_); ++i)
+  // 如果节点是可驱逐的，设置为不可驱逐并减少 cur_size_, the heap is chosen before the history grows
+  if (heap_pos_[frame_id] != NOT_IN_HEAP)
   {
-    // 当前frame是可以被淘汰的
-    if (node_store_[i].IsEvictable())
-    {
-      ULL dist = node_store_[i].GetBackwardKDistance(cur_ts_); // 获取当前frame的逆向K距离
-
-      if (dist > max_dist)
-      {
-        max_dist = dist;
-        selected_frame = i;
-        found_candidate = true;  // 找到一个候选frame
-        earliest_ts = node_store_[i].FetchOldestTimestamp();  // 更新时间戳
-      }
-      else if (dist == max_dist)
-      {
-        // 进一步按时间戳选择
-        timestamp_t frame_timestamp = node_store_[i].FetchOldestTimestamp();
-        if (frame_timestamp < earliest_ts)
-        {
-          selected_frame = i;
-          earliest_ts = frame_timestamp;
-        }
-      }
-    }
+    HeapOf(frame_id).Erase(frame_id);
+    cur_size_--;
   }
-
-  // 3. 处理最大逆向K距离为+inf的情况
-  if (max_dist == std::numeric_limits<ULL>::max())
+  if (victimized_[frame_id])
   {
-    // 表示有frame的逆向K距离不可计算，选择最早的时间戳
-    for (frame_id_t i = 0; i < static_cast<frame_id_t>(max_size_); ++i)
-    {
-      if (node_store_[i].IsEvictable() && node_store_[i].GetBackwardKDistance(cur_ts_) == max_dist)
-      {
-        timestamp_t frame_timestamp = node_store_[i].FetchOldestTimestamp();
-        if (frame_timestamp < earliest_ts)
-        {
-          selected_frame = i;
-          earliest_ts = frame_timestamp;
-        }
-      }
-    }
+    hist_head_[frame_id]  = 0;
+    hist_count_[frame_id] = 0;
+    victimized_[frame_id] = false;
   }
+  RecordAccess(frame_id);
+  ++cur_ts_; // 递增时间戳，每次 Pin 操作更新时间
+}
+
+void LRUKReplacer::Unpin(frame_id_t frame_id)
+{
+  std::scoped_lock lock(latch_);
+  CheckFrameId(frame_id);
 
-  // 如果找到候选frame，则淘汰它
-  if (found_candidate)
+  // frames without any access since they were victimized are not tracked
+  if (heap_pos_[frame_id] != NOT_IN_HEAP || hist_count_[frame_id] == 0 || victimized_[frame_id])
   {
-    *frame_id = selected_frame;
-    node_store_[*frame_id].ResetTimestampHistory();
-    node_store_[*frame_id].SetEvictable(false);
-    if (cur_size_ > 0)
-      cur_size_--;
-    return true;
+    return;
   }
+  HeapOf(frame_id).Push(OldestTimestamp(frame_id), frame_id);
+  cur_size_++;
+}
+
+void LRUKReplacer::Reinstate(frame_id_t frame_id)
+{
+  std::scoped_lock lock(latch_);
+  CheckFrameId(frame_id);
 
-  return false;  // 如果没有找到合适的frame，返回false
+  if (!victimized_[frame_id])
+  {
+    return;
+  }
+  victimized_[frame_id] = false;
+  HeapOf(frame_id).Push(OldestTimestamp(frame_id), frame_id);
+  cur_size_++;
 }
 
-void LRUKReplacer::Pin(frame_id_t frame_id)
+void LRUKReplacer::Remove(frame_id_t frame_id)
 {
-  // WSDB_STUDENT_TODO(l1, f1);
   std::scoped_lock lock(latch_);
+  CheckFrameId(frame_id);
 
-  // 查找 frame_id 是否已经存在于 node_store_
-  auto node_itr = node_store_.find(frame_id);
+  if (heap_pos_[frame_id] != NOT_IN_HEAP)
+  {
+    HeapOf(frame_id).Erase(frame_id);
+    cur_size_--;
+  }
+  hist_head_[frame_id]  = 0;
+  hist_count_[frame_id] = 0;
+  victimized_[frame_id] = false;
+}
 
-  // 如果不存在，创建新的节点并插入
-  if (node_itr == node_store_.end())
+auto LRUKReplacer::Size() -> size_t
+{
+  std::scoped_lock lock(latch_);
+  return cur_size_;
+}
+
+void LRUKReplacer::RecordAccess(frame_id_t frame_id)
+{
+  auto  ring  = history_.begin() + static_cast<long>(frame_id * k_);
+  auto& head  = hist_head_[frame_id];
+  auto& count = hist_count_[frame_id];
+  if (count < k_)
   {
-    node_store_.emplace(frame_id, LRUKNode(frame_id, k_));  // 使用 emplace 构造对象并插入
-    node_store_[frame_id].AddHistory(cur_ts_);  // 直接添加当前时间戳到历史记录
+    ring[(head + count) % k_] = cur_ts_;
+    count++;
   }
-  // 如果存在，更新节点历史记录
   else
   {
-    LRUKNode& node = node_itr->second;
-    node.AddHistory(cur_ts_);  // 添加当前时间戳到历史记录
-
-    // 如果节点是可驱逐的，设置为不可驱逐并减少 cur_size_
-    if (node.IsEvictable())
-    {
-      node.SetEvictable(false);
-      if (cur_size_ > 0)
-      {
-        --cur_size_;
-      }
-    }
+    // the ring is full, the oldest timestamp is overwritten
+    ring[head] = cur_ts_;
+    head       = (head + 1) % k_;
   }
+}
 
-  ++cur_ts_; // 递增时间戳，每次 Pin 操作更新时间
+void LRUKReplacer::FrameHeap::Push(timestamp_t key, frame_id_t frame_id)
+{
+  entries_.emplace_back(key, frame_id);
+  (*pos_)[frame_id] = static_cast<int32_t>(entries_.size() - 1);
+  SiftUp(entries_.size() - 1);
 }
 
-void LRUKReplacer::Unpin(frame_id_t frame_id)
+void LRUKReplacer::FrameHeap::Erase(frame_id_t frame_id)
 {
-  // WSDB_STUDENT_TODO(l1, f1);
-  std::scoped_lock lock(latch_);
+  auto idx  = static_cast<size_t>((*pos_)[frame_id]);
+  auto last = entries_.size() - 1;
+  if (idx != last)
+  {
+    Swap(idx, last);
+  }
+  entries_.pop_back();
+  (*pos_)[frame_id] = NOT_IN_HEAP;
+  if (idx < entries_.size())
+  {
+    SiftUp(idx);
+    SiftDown(idx);
+  }
+}
 
-  // 查找 frame_id 是否在 node_store_ 中
-  auto node_itr = node_store_.find(frame_id);
+void LRUKReplacer::FrameHeap::Swap(size_t a, size_t b)
+{
+  std::swap(entries_[a], entries_[b]);
+  (*pos_)[entries_[a].second] = static_cast<int32_t>(a);
+  (*pos_)[entries_[b].second] = static_cast<int32_t>(b);
+}
 
-  // 如果找到了对应的节点
-  if (node_itr != node_store_.end())
+void LRUKReplacer::FrameHeap::SiftUp(size_t idx)
+{
+  while (idx > 0)
   {
-    LRUKNode& node = node_itr->second;
-
-    // 如果节点当前不可驱逐，标记为可驱逐并增加 cur_size_
-    if (!node.IsEvictable())
+    auto parent = (idx - 1) / 2;
+    if (entries_[parent].first <= entries_[idx].first)
     {
-      node.SetEvictable(true);  // 标记为可驱逐
-      ++cur_size_;              // 增加可驱逐的节点计数
+      break;
     }
+    Swap(parent, idx);
+    idx = parent;
   }
 }
 
-auto LRUKReplacer::Size() -> size_t
+void LRUKReplacer::FrameHeap::SiftDown(size_t idx)
 {
-  // WSDB_STUDENT_TODO(l1, f1);
-  std::scoped_lock lock(latch_);
-
-  return cur_size_;
+  while (true)
+  {
+    auto left     = 2 * idx + 1;
+    auto right    = left + 1;
+    auto smallest = idx;
+    if (left < entries_.size() && entries_[left].first < entries_[smallest].first)
+    {
+      smallest = left;
+    }
+    if (right < entries_.size() && entries_[right].first < entries_[smallest].first)
+    {
+      smallest = right;
+    }
+    if (smallest == idx)
+    {
+      break;
+    }
+    Swap(idx, smallest);
+    idx = smallest;
+  }
 }
 
-}  // namespace wsdb
\ No newline at end of file
+}  // namespace wsdb
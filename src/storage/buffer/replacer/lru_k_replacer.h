@@ -21,18 +21,31 @@
 
 #ifndef WSDB_LRU_K_REPLACER_H
 #define WSDB_LRU_K_REPLACER_H
-#include <list>
 #include <mutex>
-#include <unordered_map>
+#include <utility>
+#include <vector>
 #include "replacer.h"
 #include "../common/error.h"
 
 namespace wsdb {
 
+/**
+ * LRUKReplacer evicts the frame whose k-th most recent access is the oldest, frames with fewer than k accesses
+ * have an infinite backward k-distance and are evicted first, in the order of their oldest access.
+ *
+ * The last k access timestamps of each frame are kept in a fixed slot of one flat ring buffer array. Since the
+ * history is capped at k, the oldest retained timestamp is exactly the k-th most recent access for frames with a
+ * full history, so evictable frames are ordered by that timestamp in two min-heaps, one for infinite distances
+ * and one for k-distances. All memory is allocated up front and Victim, Pin and Unpin take O(log n).
+ */
 class LRUKReplacer : public Replacer
 {
 public:
- explicit LRUKReplacer(size_t k);
+ /**
+  * @param k
+  * @param max_size number of frames of the buffer pool
+  */
+ LRUKReplacer(size_t k, size_t max_size);
 
  ~LRUKReplacer() override = default;
 
@@ -42,95 +55,78 @@ public:
 
  void Unpin(frame_id_t frame_id) override;
 
+ /**
+  * Push a victimized frame back into its heap by its retained history, which Victim keeps until the frame is
+  * pinned again
+  */
+ void Reinstate(frame_id_t frame_id) override;
+
+ /**
+  * Take the frame out of its heap and forget its history
+  */
+ void Remove(frame_id_t frame_id) override;
+
  auto Size() -> size_t override;
 
 private:
- class LRUKNode
+ /**
+  * Binary min-heap of frames keyed by their oldest retained timestamp, heap_pos_ of the replacer maps a frame
+  * to its slot so that any frame can be removed in O(log n)
+  */
+ class FrameHeap
  {
  public:
-   LRUKNode() = default;
-
-   explicit LRUKNode(frame_id_t fid, size_t k) : fid_(fid), k(k), is_evictable_(false) {}
-
-   void AddHistory(timestamp_t ts)
-   {
-     // WSDB_STUDENT_TODO(l1, f1);
-     history_.push_back(ts);
-     while (history_.size() > k)
-     {
-       history_.erase(history_.begin());
-     }
-   }
-
-   /**
-    * Get the distance between the current timestamp and the k-th timestamp in the history,
-    * think: why return type is unsigned long long?
-    * @param cur_ts
-    * @return
-    */
-   auto GetBackwardKDistance(timestamp_t cur_ts) -> unsigned long long
-   {
-     // WSDB_STUDENT_TODO(l1, f1);
-     if (history_.size() < k)
-     {
-       return std::numeric_limits<unsigned long long>::max(); // 历史列表中不足k个时间戳
-     }
-
-     size_t count = 0; // 用于计数，找到第k个时间戳
-     for (auto it = history_.rbegin(); it != history_.rend() && count < k; ++it)
-     {
-       if (count + 1 == k)
-       {
-         // 找到第k个时间戳，计算与当前时间戳的差值
-         return cur_ts - *it;
-       }
-       ++count;
-     }
-     return std::numeric_limits<unsigned long long>::max(); // 理论上不会执行到这里，因为前面已经检查过历史列表的大小
-   }
-
-   [[nodiscard]] auto IsEvictable() const -> bool
-   {
-     // WSDB_STUDENT_TODO(l1, f1);
-     return is_evictable_;
-   }
-
-   auto SetEvictable(bool set_evictable) -> void
-   {
-     // WSDB_STUDENT_TODO(l1, f1);
-     is_evictable_ = set_evictable;
-   }
-
-   // 自定义辅助函数
-   auto FetchOldestTimestamp() const -> timestamp_t
-   {
-     if (!history_.empty())
-       return *history_.begin();  // 使用迭代器获取第一个元素
-     throw std::runtime_error("History is empty");  // 如果为空，抛出异常
-   }
-
-   auto ResetTimestampHistory() -> void
-   {
-     while (!history_.empty()) {
-       history_.pop_front();  // 按顺序清空每个元素
-     }
-   }
+   FrameHeap(size_t capacity, std::vector<int32_t> *pos) : pos_(pos) { entries_.reserve(capacity); }
+
+   [[nodiscard]] auto Empty() const -> bool { return entries_.empty(); }
+
+   [[nodiscard]] auto Top() const -> frame_id_t { return entries_.front().second; }
+
+   void Push(timestamp_t key, frame_id_t frame_id);
+
+   void Erase(frame_id_t frame_id);
 
  private:
-   std::list<timestamp_t> history_;
-   frame_id_t             fid_{INVALID_FRAME_ID};
-   size_t                 k{};
-   bool                   is_evictable_{};
+   void Swap(size_t a, size_t b);
+
+   void SiftUp(size_t idx);
+
+   void SiftDown(size_t idx);
+
+   std::vector<std::pair<timestamp_t, frame_id_t>> entries_;
+   std::vector<int32_t>                           *pos_;
  };
 
+ static constexpr int32_t NOT_IN_HEAP = -1;
+
+ void RecordAccess(frame_id_t frame_id);
+
+ [[nodiscard]] auto OldestTimestamp(frame_id_t frame_id) const -> timestamp_t
+ {
+   return history_[frame_id * k_ + hist_head_[frame_id]];
+ }
+
+ auto HeapOf(frame_id_t frame_id) -> FrameHeap & { return hist_count_[frame_id] < k_ ? inf_heap_ : k_heap_; }
+
+ void CheckFrameId(frame_id_t frame_id) const
+ {
+   WSDB_ASSERT(frame_id >= 0 && static_cast<size_t>(frame_id) < max_size_, "frame id out of range");
+ }
+
 private:
- std::unordered_map<frame_id_t, LRUKNode> node_store_;  // frame_id -> LRUKNode
- size_t                                   cur_ts_{0};
- size_t                                   cur_size_{0};  // number of evictable frames
- size_t                                   max_size_;     // maximum number of frames that can be stored
- size_t                                   k_;            // k for LRU-k
- std::mutex                               latch_;        // mutex for curr_size_, node_store_, and curr_timestamp_
+ size_t                   max_size_;  // maximum number of frames that can be stored
+ size_t                   k_;         // k for LRU-k
+ std::vector<timestamp_t> history_;     // ring buffer of k timestamps per frame, frame i owns [i * k, (i + 1) * k)
+ std::vector<uint32_t>    hist_head_;   // slot of the oldest timestamp in the ring of each frame
+ std::vector<uint32_t>    hist_count_;  // number of timestamps in the ring of each frame
+ std::vector<int32_t>     heap_pos_;    // slot of each evictable frame in its heap, NOT_IN_HEAP otherwise
+ std::vector<bool>        victimized_;  // frames returned by Victim and not pinned since, their history is stale
+ FrameHeap                inf_heap_;    // evictable frames with fewer than k accesses
+ FrameHeap                k_heap_;      // evictable frames with k accesses
+ size_t                   cur_ts_{0};
+ size_t                   cur_size_{0};  // number of evictable frames
+ std::mutex               latch_;        // mutex for all the states above
 };
 }  // namespace wsdb
 
-#endif  // WSDB_LRU_K_REPLACER_H
\ No newline at end of file
+#endif  // WSDB_LRU_K_REPLACER_H
@@ -25,7 +25,7 @@
 #include <algorithm>
 namespace wsdb {
 
-LRUReplacer::LRUReplacer() : cur_size_(0), max_size_(BUFFER_POOL_SIZE) {}
+LRUReplacer::LRUReplacer(size_t max_size) : cur_size_(0), max_size_(max_size) {}
 
 auto LRUReplacer::Victim(frame_id_t *frame_id) -> bool {
  //WSDB_STUDENT_TODO(l1, t1);
@@ -39,13 +39,6 @@ auto LRUReplacer::Victim(frame_id_t *frame_id) -> bool {
  }
  // 找到链表中第一个可淘汰的帧
  for (auto it = lru_list_.begin(); it != lru_list_.end(); ++it)
- {
-   if (it->second) // 可被淘汰
-   {
-     *frame_id = it->first;
-   }
- }
- for (auto it = lru_list_.begin(); it != lru_list_.end(); ++it)
  {
    if (it->second) // 可被淘汰
    {
@@ -69,13 +62,13 @@ void LRUReplacer::Pin(frame_id_t frame_id) {
  auto it = lru_hash_.find(frame_id);
  if (it != lru_hash_.end())
  {
-   // 如果帧已经在链表中
-   lru_list_.erase(it->second);  // 从旧位置移除
-   lru_hash_.erase(it);
-   if (cur_size_ > 0)
+   // 如果帧已经在链表中, only an evictable frame is counted in cur_size_
+   if (it->second->second)
    {
      --cur_size_;
    }
+   lru_list_.erase(it->second);  // 从旧位置移除
+   lru_hash_.erase(it);
  }
  // 添加到链表尾部并标记为不可淘汰
  lru_list_.emplace_back(frame_id, false);
@@ -104,6 +97,35 @@ void LRUReplacer::Unpin(frame_id_t frame_id) {
  ++cur_size_;
 }
 
+void LRUReplacer::Reinstate(frame_id_t frame_id)
+{
+ std::scoped_lock lock(latch_);
+ if (lru_hash_.count(frame_id) != 0)
+ {
+   return;
+ }
+ // the victim was the least recently used frame, it keeps that position
+ lru_list_.emplace_front(frame_id, true);
+ lru_hash_[frame_id] = lru_list_.begin();
+ ++cur_size_;
+}
+
+void LRUReplacer::Remove(frame_id_t frame_id)
+{
+ std::scoped_lock lock(latch_);
+ auto it = lru_hash_.find(frame_id);
+ if (it == lru_hash_.end())
+ {
+   return;
+ }
+ if (it->second->second)
+ {
+   --cur_size_;
+ }
+ lru_list_.erase(it->second);
+ lru_hash_.erase(it);
+}
+
 auto LRUReplacer::Size() -> size_t {
  //WSDB_STUDENT_TODO(l1, t1);
 
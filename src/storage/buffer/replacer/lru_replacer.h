@@ -34,8 +34,9 @@ class LRUReplacer : public Replacer
 public:
  /**
   * Create a new LRUReplacer.
+  * @param max_size number of frames of the buffer pool
   */
- explicit LRUReplacer();
+ explicit LRUReplacer(size_t max_size);
 
  /**
   * Destroys the LRUReplacer.
@@ -70,6 +71,18 @@ public:
   */
  void Unpin(frame_id_t frame_id) override;
 
+ /**
+  * Put a victimized frame back at the least recently used end of the LRU list
+  * @param frame_id
+  */
+ void Reinstate(frame_id_t frame_id) override;
+
+ /**
+  * Drop the frame from the LRU list and hash map
+  * @param frame_id
+  */
+ void Remove(frame_id_t frame_id) override;
+
  /**
   * Get the number of elements in the replacer that can be victimized.
   * 1. grant the latch
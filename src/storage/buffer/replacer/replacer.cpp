@@ -20,3 +20,25 @@
 //
 
 #include "replacer.h"
+#include "lru_replacer.h"
+#include "lru_k_replacer.h"
+#include "clock_replacer.h"
+#include "../common/error.h"
+
+namespace wsdb {
+
+auto Replacer::Create(const std::string &name, size_t max_size, size_t lru_k) -> std::unique_ptr<Replacer>
+{
+  if (name == "LRUReplacer") {
+    return std::make_unique<LRUReplacer>(max_size);
+  }
+  if (name == "LRUKReplacer") {
+    return std::make_unique<LRUKReplacer>(lru_k, max_size);
+  }
+  if (name == "ClockReplacer") {
+    return std::make_unique<ClockReplacer>(max_size);
+  }
+  WSDB_FETAL("Unknown replacer: " + name);
+}
+
+}  // namespace wsdb
@@ -22,6 +22,8 @@
 #ifndef NJU_DBCOURSE_REPLACER_H
 #define NJU_DBCOURSE_REPLACER_H
 
+#include <memory>
+#include <string>
 #include "common/types.h"
 
 namespace wsdb {
@@ -54,8 +56,30 @@ public:
    */
   virtual void Unpin(frame_id_t frame_id) = 0;
 
+  /**
+   * Return a frame taken by Victim to the evictable frames where it was, without recording an access,
+   * used when the caller cannot evict the victim after all.
+   * @param frame_id the id of the frame Victim returned
+   */
+  virtual void Reinstate(frame_id_t frame_id) = 0;
+
+  /**
+   * Stop tracking a frame without recording an access, it is neither evictable nor remembered afterwards,
+   * used when the frame is freed.
+   * @param frame_id the id of the frame to remove
+   */
+  virtual void Remove(frame_id_t frame_id) = 0;
+
   /** @return the number of elements in the replacer that can be victimized */
   virtual auto Size() -> size_t = 0;
+
+  /**
+   * Create the replacer named by name, "LRUReplacer", "LRUKReplacer" or "ClockReplacer"
+   * @param name
+   * @param max_size number of frames the replacer manages
+   * @param lru_k k of LRUKReplacer
+   */
+  static auto Create(const std::string &name, size_t max_size, size_t lru_k) -> std::unique_ptr<Replacer>;
 };
 
 }  // namespace wsdb
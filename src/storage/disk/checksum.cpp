@@ -0,0 +1,127 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#include "checksum.h"
+#include <array>
+#include <cstring>
+#include "common/page.h"
+
+#if defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
+
+namespace wsdb {
+
+namespace {
+
+constexpr uint32_t CRC32C_POLY = 0x82F63B78;  // reflected Castagnoli polynomial
+
+constexpr auto MakeCrc32cTable() -> std::array<uint32_t, 256>
+{
+  std::array<uint32_t, 256> table{};
+  for (uint32_t i = 0; i < 256; i++) {
+    uint32_t crc = i;
+    for (int bit = 0; bit < 8; bit++) {
+      crc = (crc >> 1) ^ ((crc & 1) != 0 ? CRC32C_POLY : 0);
+    }
+    table[i] = crc;
+  }
+  return table;
+}
+
+constexpr auto CRC32C_TABLE = MakeCrc32cTable();
+
+auto Crc32cSoftware(const char *data, size_t size, uint32_t crc) -> uint32_t
+{
+  const auto *bytes = reinterpret_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; i++) {
+    crc = CRC32C_TABLE[(crc ^ bytes[i]) & 0xFF] ^ (crc >> 8);
+  }
+  return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2"))) auto Crc32cHardware(const char *data, size_t size, uint32_t crc) -> uint32_t
+{
+  uint64_t crc64 = crc;
+  for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    crc64 = _mm_crc32_u64(crc64, word);
+  }
+  crc = static_cast<uint32_t>(crc64);
+  for (; size > 0; data++, size--) {
+    crc = _mm_crc32_u8(crc, static_cast<uint8_t>(*data));
+  }
+  return crc;
+}
+
+const bool HAS_HARDWARE_CRC32C = __builtin_cpu_supports("sse4.2");
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+auto Crc32cHardware(const char *data, size_t size, uint32_t crc) -> uint32_t
+{
+  for (; size >= sizeof(uint64_t); data += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    crc = __crc32cd(crc, word);
+  }
+  for (; size > 0; data++, size--) {
+    crc = __crc32cb(crc, static_cast<uint8_t>(*data));
+  }
+  return crc;
+}
+
+constexpr bool HAS_HARDWARE_CRC32C = true;
+#else
+auto Crc32cHardware(const char *data, size_t size, uint32_t crc) -> uint32_t { return Crc32cSoftware(data, size, crc); }
+
+constexpr bool HAS_HARDWARE_CRC32C = false;
+#endif
+
+}  // namespace
+
+auto Crc32c(const char *data, size_t size, uint32_t crc) -> uint32_t
+{
+  crc = ~crc;
+  crc = HAS_HARDWARE_CRC32C ? Crc32cHardware(data, size, crc) : Crc32cSoftware(data, size, crc);
+  return ~crc;
+}
+
+auto PageChecksum(const char *page) -> uint32_t
+{
+  constexpr size_t tail = PAGE_CHECKSUM_OFFSET + sizeof(uint32_t);
+  auto             crc  = Crc32c(page, PAGE_CHECKSUM_OFFSET);
+  crc                   = Crc32c(page + tail, PAGE_SIZE - tail, crc);
+  return crc == 0 ? 1 : crc;
+}
+
+void StampPageChecksum(char *page, bool enable)
+{
+  uint32_t checksum = enable ? PageChecksum(page) : 0;
+  memcpy(page + PAGE_CHECKSUM_OFFSET, &checksum, sizeof(checksum));
+}
+
+auto VerifyPageChecksum(const char *page) -> bool
+{
+  uint32_t checksum;
+  memcpy(&checksum, page + PAGE_CHECKSUM_OFFSET, sizeof(checksum));
+  return checksum == 0 || checksum == PageChecksum(page);
+}
+
+}  // namespace wsdb
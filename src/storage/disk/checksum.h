@@ -0,0 +1,52 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#ifndef WSDB_CHECKSUM_H
+#define WSDB_CHECKSUM_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace wsdb {
+
+/**
+ * CRC32C (Castagnoli), computed with the SSE4.2 or ARMv8 CRC instructions when the CPU has them and with a lookup
+ * table otherwise
+ * @param crc checksum of the preceding bytes, to checksum data in pieces
+ */
+auto Crc32c(const char *data, size_t size, uint32_t crc = 0) -> uint32_t;
+
+/**
+ * Checksum of a page, the checksum field itself is skipped. The result is never 0, a page whose field is 0 has
+ * never been stamped, e.g. a page beyond EOF or one written with checksums disabled
+ */
+auto PageChecksum(const char *page) -> uint32_t;
+
+/**
+ * Store PageChecksum in the header of the page, or clear the field if enable is false so that a stale checksum
+ * is never left behind
+ */
+void StampPageChecksum(char *page, bool enable = true);
+
+/**
+ * @return true if the page is unstamped or its checksum matches
+ */
+auto VerifyPageChecksum(const char *page) -> bool;
+
+}  // namespace wsdb
+
+#endif  // WSDB_CHECKSUM_H
@@ -19,10 +19,18 @@
 // Created by ziqi on 2024/7/17.
 //
 
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
 #include <filesystem>
+#include <mutex>
 #include <fcntl.h>
+#include <sys/stat.h>
 #include <unistd.h>
 #include "disk_manager.h"
+#include "checksum.h"
+#include "common/page.h"
 #include "../../common/config.h"
 #include "../../../common/error.h"
 
@@ -50,10 +58,11 @@ void DiskManager::DestroyFile(const std::string &fname)
   }
 }
 
-auto DiskManager::OpenFile(const std::string &fname) -> file_id_t
+auto DiskManager::OpenFile(const std::string &fname, bool direct_io) -> file_id_t
 {
   if (!FileExists(fname))
     WSDB_THROW(WSDB_FILE_NOT_EXISTS, fname);
+  std::unique_lock lock(latch_);
   if (name_fid_map_.find(fname) != name_fid_map_.end()) {
     WSDB_THROW(WSDB_FILE_REOPEN, fname);
   } else {
@@ -63,44 +72,141 @@ auto DiskManager::OpenFile(const std::string &fname) -> file_id_t
     }
     name_fid_map_.insert(std::make_pair(fname, fd));
     fid_name_map_.insert(std::make_pair(fd, fname));
+    if (direct_io) {
+      if (int direct_fd = open(fname.c_str(), O_RDWR | O_DIRECT); direct_fd != -1) {
+        direct_fds_.insert(std::make_pair(fd, direct_fd));
+      } else {
+        WSDB_LOG(fmt::format("{}: O_DIRECT is not available ({}), use buffered I/O", fname, strerror(errno)));
+      }
+    }
     return fd;
   }
 }
 
 void DiskManager::CloseFile(file_id_t fid)
 {
+  std::unique_lock lock(latch_);
   if (fid_name_map_.find(fid) == fid_name_map_.end()) {
     WSDB_THROW(WSDB_FILE_NOT_OPEN, fmt::format("fid: {}", fid));
   } else {
     name_fid_map_.erase(fid_name_map_[fid]);
     fid_name_map_.erase(fid);
+    if (auto it = direct_fds_.find(fid); it != direct_fds_.end()) {
+      close(it->second);
+      direct_fds_.erase(it);
+    }
     close(fid);
   }
 }
 
-void DiskManager::WritePage(file_id_t fid, page_id_t page_id, const char *data)
+void DiskManager::WritePage(file_id_t fid, page_id_t page_id, char *data)
 {
-  WSDB_ASSERT(fid_name_map_.find(fid) != fid_name_map_.end(), fmt::format("fid: {}", fid));
-  lseek(fid, static_cast<off_t>(page_id) * static_cast<off_t>(PAGE_SIZE), SEEK_SET);
-  if (write(fid, data, PAGE_SIZE) != PAGE_SIZE) {
-    WSDB_THROW(
-        WSDB_FILE_WRITE_ERROR, fmt::format("fid: {}, page_id: {}", fid, page_id));
+  CheckFileOpened(fid);
+  if (page_id != FILE_HEADER_PAGE_ID) {
+    StampPageChecksum(data, page_checksum_);
+  }
+  auto offset = static_cast<off_t>(page_id) * static_cast<off_t>(PAGE_SIZE);
+  auto fd     = PageFd(fid, IsAligned(data));
+  if (PWriteFull(fd, data, PAGE_SIZE, offset) != static_cast<ssize_t>(PAGE_SIZE)) {
+    WSDB_THROW(WSDB_FILE_WRITE_ERROR, fmt::format("fid: {}, page_id: {}, {}", fid, page_id, strerror(errno)));
+  }
+}
+
+void DiskManager::AllocatePages(file_id_t fid, page_id_t first_pid, size_t count)
+{
+  CheckFileOpened(fid);
+  auto offset = static_cast<off_t>(first_pid) * static_cast<off_t>(PAGE_SIZE);
+  // posix_fallocate returns the error instead of setting errno
+  if (auto err = posix_fallocate(fid, offset, static_cast<off_t>(count * PAGE_SIZE)); err != 0) {
+    WSDB_THROW(WSDB_FILE_WRITE_ERROR,
+        fmt::format("fid: {}, allocate {} pages from page_id {}, {}", fid, count, first_pid, strerror(err)));
+  }
+}
+
+auto DiskManager::MapFile(file_id_t fid, size_t page_num) -> MappedFileUptr
+{
+  page_num = std::min(page_num, GetPageNum(fid));
+  return std::make_unique<MappedFile>(fid, page_num, page_checksum_);
+}
+
+auto DiskManager::GetPageNum(file_id_t fid) -> size_t
+{
+  CheckFileOpened(fid);
+  struct stat st{};
+  if (fstat(fid, &st) != 0) {
+    WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("fid: {}, {}", fid, strerror(errno)));
   }
+  return static_cast<size_t>(st.st_size) / PAGE_SIZE;
 }
 
 void DiskManager::ReadPage(file_id_t fid, page_id_t page_id, char *data)
 {
-  WSDB_ASSERT(fid_name_map_.find(fid) != fid_name_map_.end(), fmt::format("fid: {}", fid));
-  lseek(fid, static_cast<off_t>(page_id) * static_cast<off_t>(PAGE_SIZE), SEEK_SET);
-  if (read(fid, data, PAGE_SIZE) < 0) {
-    WSDB_THROW(
-        WSDB_FILE_READ_ERROR, fmt::format("fid: {}, page_id: {}", fid, page_id));
+  CheckFileOpened(fid);
+  auto offset = static_cast<off_t>(page_id) * static_cast<off_t>(PAGE_SIZE);
+  auto nread  = PReadFull(PageFd(fid, IsAligned(data)), data, PAGE_SIZE, offset);
+  if (nread < 0) {
+    WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("fid: {}, page_id: {}, {}", fid, page_id, strerror(errno)));
+  }
+  // page is (partially) beyond EOF, e.g. a newly allocated page
+  if (static_cast<size_t>(nread) < PAGE_SIZE) {
+    memset(data + nread, 0, PAGE_SIZE - nread);
+  }
+  if (page_checksum_ && page_id != FILE_HEADER_PAGE_ID && !VerifyPageChecksum(data)) {
+    WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("fid: {}, page_id: {}, checksum mismatch", fid, page_id));
+  }
+}
+
+void DiskManager::ReadPagesAsync(
+    file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs, IOEngine::Callback cb)
+{
+  CheckFileOpened(fid);
+  WSDB_ASSERT(pids.size() == bufs.size(), "pids and bufs mismatch");
+  if (page_checksum_) {
+    cb = [this, fid, pids, bufs, cb = std::move(cb)](bool ok) { cb(ok && VerifyPages(fid, pids, bufs)); };
   }
+  GetIOEngine().Submit(BuildRequests(PageFd(fid, IsAligned(bufs)), pids, bufs, false), std::move(cb));
+}
+
+auto DiskManager::ReadPagesAsync(file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs)
+    -> std::future<void>
+{
+  auto [future, cb] = MakeFuture(false, fid);
+  ReadPagesAsync(fid, pids, bufs, std::move(cb));
+  return std::move(future);
+}
+
+void DiskManager::WritePages(file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs)
+{
+  CheckFileOpened(fid);
+  WSDB_ASSERT(pids.size() == bufs.size(), "pids and bufs mismatch");
+  StampPages(pids, bufs);
+  for (const auto &req : BuildRequests(PageFd(fid, IsAligned(bufs)), pids, bufs, true)) {
+    if (!IOEngine::ExecuteSync(req)) {
+      WSDB_THROW(WSDB_FILE_WRITE_ERROR, fmt::format("fid: {}, offset: {}, {}", fid, req.offset_, strerror(errno)));
+    }
+  }
+}
+
+void DiskManager::WritePagesAsync(
+    file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs, IOEngine::Callback cb)
+{
+  CheckFileOpened(fid);
+  WSDB_ASSERT(pids.size() == bufs.size(), "pids and bufs mismatch");
+  StampPages(pids, bufs);
+  GetIOEngine().Submit(BuildRequests(PageFd(fid, IsAligned(bufs)), pids, bufs, true), std::move(cb));
+}
+
+auto DiskManager::WritePagesAsync(
+    file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs) -> std::future<void>
+{
+  auto [future, cb] = MakeFuture(true, fid);
+  WritePagesAsync(fid, pids, bufs, std::move(cb));
+  return std::move(future);
 }
 
 void DiskManager::ReadFile(file_id_t fid, char *data, size_t size, size_t offset, int type)
 {
-  WSDB_ASSERT(fid_name_map_.find(fid) != fid_name_map_.end(), "File not Opened");
+  CheckFileOpened(fid);
   lseek(fid, static_cast<off_t>(offset), type);
   if(read(fid, data, size) < 0) {
     WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("fid: {}", fid));
@@ -109,7 +215,7 @@ void DiskManager::ReadFile(file_id_t fid, char *data, size_t size, size_t offset
 
 void DiskManager::WriteFile(file_id_t fid, const char *data, size_t size, int type)
 {
-  WSDB_ASSERT(fid_name_map_.find(fid) != fid_name_map_.end(), "File not Opened");
+  CheckFileOpened(fid);
   WSDB_ASSERT(type == SEEK_CUR || type == SEEK_SET || type == SEEK_END, "Invalid Type");
   lseek(fid, 0, type);
   if(write(fid, data, size) < 0) {
@@ -123,7 +229,8 @@ void DiskManager::ReadLog(const std::string &log_file, std::string &log_string)
 
 auto DiskManager::GetFileId(const std::string &fname) -> file_id_t
 {
-  auto it = name_fid_map_.find(fname);
+  std::shared_lock lock(latch_);
+  auto             it = name_fid_map_.find(fname);
   if (it != name_fid_map_.end()) {
     return it->second;
   } else {
@@ -133,7 +240,8 @@ auto DiskManager::GetFileId(const std::string &fname) -> file_id_t
 
 auto DiskManager::GetFileName(file_id_t fid) -> std::string
 {
-  auto it = fid_name_map_.find(fid);
+  std::shared_lock lock(latch_);
+  auto             it = fid_name_map_.find(fid);
   if (it != fid_name_map_.end()) {
     return it->second;
   } else {
@@ -143,4 +251,143 @@ auto DiskManager::GetFileName(file_id_t fid) -> std::string
 
 auto DiskManager::FileExists(const std::string &fname) -> bool { return std::filesystem::exists(fname); }
 
+auto DiskManager::PReadFull(int fd, char *data, size_t size, off_t offset) -> ssize_t
+{
+  size_t done = 0;
+  while (done < size) {
+    auto ret = pread(fd, data + done, size - done, offset + static_cast<off_t>(done));
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    if (ret == 0) {
+      break;  // EOF
+    }
+    done += static_cast<size_t>(ret);
+  }
+  return static_cast<ssize_t>(done);
+}
+
+auto DiskManager::PWriteFull(int fd, const char *data, size_t size, off_t offset) -> ssize_t
+{
+  size_t done = 0;
+  while (done < size) {
+    auto ret = pwrite(fd, data + done, size - done, offset + static_cast<off_t>(done));
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    done += static_cast<size_t>(ret);
+  }
+  return static_cast<ssize_t>(done);
+}
+
+auto DiskManager::BuildRequests(int fd, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs,
+    bool is_write) -> std::vector<IORequest>
+{
+  std::vector<size_t> order(pids.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::sort(order.begin(), order.end(), [&pids](size_t a, size_t b) { return pids[a] < pids[b]; });
+  std::vector<IORequest> reqs;
+  for (size_t i = 0; i < order.size(); ++i) {
+    auto pid = pids[order[i]];
+    if (reqs.empty() || reqs.back().iovs_.size() == IOV_MAX || pids[order[i - 1]] + 1 != pid) {
+      IORequest req;
+      req.fd_       = fd;
+      req.offset_   = static_cast<off_t>(pid) * static_cast<off_t>(PAGE_SIZE);
+      req.is_write_ = is_write;
+      reqs.push_back(std::move(req));
+    }
+    reqs.back().iovs_.push_back({bufs[order[i]], PAGE_SIZE});
+  }
+  return reqs;
+}
+
+auto DiskManager::MakeFuture(bool is_write, file_id_t fid) -> std::pair<std::future<void>, IOEngine::Callback>
+{
+  auto promise = std::make_shared<std::promise<void>>();
+  auto future  = promise->get_future();
+  auto cb      = [promise, is_write, fid](bool ok) {
+    if (ok) {
+      promise->set_value();
+      return;
+    }
+    try {
+      if (is_write) {
+        WSDB_THROW(WSDB_FILE_WRITE_ERROR, fmt::format("fid: {}, async page write failed", fid));
+      } else {
+        WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("fid: {}, async page read failed", fid));
+      }
+    } catch (...) {
+      promise->set_exception(std::current_exception());
+    }
+  };
+  return {std::move(future), std::move(cb)};
+}
+
+auto DiskManager::GetIOEngine() -> IOEngine &
+{
+  std::call_once(io_engine_once_, [this] { io_engine_ = IOEngine::Create(IO_WORKER_NUM); });
+  return *io_engine_;
+}
+
+void DiskManager::CheckFileOpened(file_id_t fid) const
+{
+  std::shared_lock lock(latch_);
+  WSDB_ASSERT(fid_name_map_.find(fid) != fid_name_map_.end(), fmt::format("fid: {}", fid));
+}
+
+auto DiskManager::PageFd(file_id_t fid, bool aligned) const -> int
+{
+  if (!aligned) {
+    return fid;
+  }
+  std::shared_lock lock(latch_);
+  auto             it = direct_fds_.find(fid);
+  return it == direct_fds_.end() ? fid : it->second;
+}
+
+auto DiskManager::IsAligned(const char *buf) -> bool
+{
+  // O_DIRECT needs the memory aligned to the logical block size, page alignment covers every device
+  return reinterpret_cast<uintptr_t>(buf) % PAGE_SIZE == 0;
+}
+
+auto DiskManager::IsAligned(const std::vector<char *> &bufs) -> bool
+{
+  return std::all_of(bufs.begin(), bufs.end(), [](const char *buf) { return IsAligned(buf); });
+}
+
+void DiskManager::StampPages(const std::vector<page_id_t> &pids, const std::vector<char *> &bufs) const
+{
+  for (size_t i = 0; i < pids.size(); ++i) {
+    if (pids[i] != FILE_HEADER_PAGE_ID) {
+      // with checksums disabled the field is cleared, a stale checksum would fail once they are enabled again
+      StampPageChecksum(bufs[i], page_checksum_);
+    }
+  }
+}
+
+auto DiskManager::VerifyPages(file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs) const
+    -> bool
+{
+  if (!page_checksum_) {
+    return true;
+  }
+  bool ok = true;
+  for (size_t i = 0; i < pids.size(); ++i) {
+    if (pids[i] != FILE_HEADER_PAGE_ID && !VerifyPageChecksum(bufs[i])) {
+      WSDB_LOG_ERROR(fmt::format("fid: {}, page_id: {}, checksum mismatch", fid, pids[i]));
+      ok = false;
+    }
+  }
+  return ok;
+}
+
 }  // namespace wsdb
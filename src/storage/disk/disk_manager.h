@@ -25,14 +25,24 @@
 #include <iostream>
 #include <fstream>
 #include <future>
+#include <mutex>
+#include <shared_mutex>
 #include <unordered_map>
+#include <vector>
+#include "common/config.h"
 #include "common/types.h"
+#include "io_engine.h"
+#include "mapped_file.h"
 
 namespace wsdb {
 class DiskManager
 {
 public:
-  DiskManager() = default;
+  /**
+   * @param page_checksum stamp pages with a checksum on write and verify it on read, the file header page is
+   * written with WriteFile and never checksummed
+   */
+  explicit DiskManager(bool page_checksum = PAGE_CHECKSUM) : page_checksum_(page_checksum) {}
 
   ~DiskManager() = default;
 
@@ -53,8 +63,11 @@ public:
    * Open the file named tab_name, add the opened file to the file map, and return the table id
    * If table does not exist, return -1
    * @param tab_name
+   * @param direct_io also open the file with O_DIRECT, page I/O on page-aligned buffers then bypasses the OS page
+   * cache, which only double-buffers what the buffer pool caches. Other I/O, like the file header written with
+   * WriteFile, stays buffered. Falls back to buffered I/O if the file system does not support O_DIRECT
    */
-  auto OpenFile(const std::string &fname) -> file_id_t;
+  auto OpenFile(const std::string &fname, bool direct_io = false) -> file_id_t;
 
   /**
    * Close the file given table id, and remove related information from structures
@@ -62,10 +75,93 @@ public:
    */
   void CloseFile(file_id_t fid);
 
-  void WritePage(file_id_t fid, page_id_t page_id, const char *data);
+  /**
+   * Write a page at its position in the file, positional I/O does not touch the shared file offset,
+   * so concurrent page reads and writes on the same file are safe. The checksum field of data is stamped before
+   * the write, as in all page writes below, so data is modified and nobody else may modify or read it meanwhile
+   * @param fid
+   * @param page_id
+   * @param data
+   */
+  void WritePage(file_id_t fid, page_id_t page_id, char *data);
 
+  /**
+   * Reserve disk space for pages [first_pid, first_pid + count) with posix_fallocate, the file is extended and
+   * the pages read as zeros until they are written
+   * @param fid
+   * @param first_pid
+   * @param count
+   */
+  void AllocatePages(file_id_t fid, page_id_t first_pid, size_t count);
+
+  /**
+   * Map the first page_num pages of an opened file read-only, pages beyond EOF are left out of the mapping since
+   * touching them would fault. The mapping verifies page checksums if they are enabled and must not outlive the file
+   * @param fid
+   * @param page_num
+   * @return
+   */
+  auto MapFile(file_id_t fid, size_t page_num) -> MappedFileUptr;
+
+  /**
+   * Number of whole pages in the file on disk, pages only allocated in the buffer pool are not counted
+   * @param fid
+   * @return
+   */
+  auto GetPageNum(file_id_t fid) -> size_t;
+
+  /**
+   * Read a page from its position in the file, the part of the page beyond EOF is zero-filled.
+   * Throws WSDB_FILE_READ_ERROR if the checksum of the page does not match
+   * @param fid
+   * @param page_id
+   * @param data
+   */
   void ReadPage(file_id_t fid, page_id_t page_id, char *data);
 
+  /**
+   * Read a batch of pages asynchronously, pages with adjacent ids are coalesced into one vectored read.
+   * Pages beyond EOF are zero-filled as in ReadPage
+   * @param fid
+   * @param pids
+   * @param bufs bufs[i] receives page pids[i], buffers must stay valid until the batch completes
+   * @param cb invoked from an I/O thread once all pages are read, with false if a page failed its checksum
+   */
+  void ReadPagesAsync(
+      file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs, IOEngine::Callback cb);
+
+  /**
+   * Future flavor of ReadPagesAsync, get() throws WSDB_FILE_READ_ERROR if any page failed
+   */
+  auto ReadPagesAsync(file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs)
+      -> std::future<void>;
+
+  /**
+   * Write a batch of pages in the calling thread, pages with adjacent ids are coalesced into one vectored write.
+   * Unlike WritePagesAsync it never waits for the I/O engine, so it can be called by holders of latches that
+   * completion callbacks take
+   * @param fid
+   * @param pids
+   * @param bufs bufs[i] holds page pids[i]
+   */
+  void WritePages(file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs);
+
+  /**
+   * Write a batch of pages asynchronously, pages with adjacent ids are coalesced into one vectored write
+   * @param fid
+   * @param pids
+   * @param bufs bufs[i] holds page pids[i], buffers must stay valid until the batch completes
+   * @param cb invoked from an I/O thread once all pages are written
+   */
+  void WritePagesAsync(
+      file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs, IOEngine::Callback cb);
+
+  /**
+   * Future flavor of WritePagesAsync, get() throws WSDB_FILE_WRITE_ERROR if any page failed
+   */
+  auto WritePagesAsync(file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs)
+      -> std::future<void>;
+
   void ReadFile(file_id_t fid, char *data, size_t size, size_t offset, int type);
 
   /**
@@ -85,11 +181,64 @@ public:
 
   auto GetFileName(file_id_t fid) -> std::string;
 
+  [[nodiscard]] auto IsPageChecksumEnabled() const -> bool { return page_checksum_; }
+
   static auto FileExists(const std::string &fname) -> bool;
 
 private:
+  /**
+   * pread until size bytes are read or EOF is reached, retry on EINTR
+   * @return number of bytes read, -1 on error
+   */
+  static auto PReadFull(int fd, char *data, size_t size, off_t offset) -> ssize_t;
+
+  /**
+   * pwrite until all size bytes are written, retry on EINTR
+   * @return number of bytes written, -1 on error
+   */
+  static auto PWriteFull(int fd, const char *data, size_t size, off_t offset) -> ssize_t;
+
+  void CheckFileOpened(file_id_t fid) const;
+
+  /**
+   * The descriptor page I/O on the file should use, the O_DIRECT one if the file has one and the buffers are aligned
+   */
+  auto PageFd(file_id_t fid, bool aligned) const -> int;
+
+  static auto IsAligned(const char *buf) -> bool;
+
+  static auto IsAligned(const std::vector<char *> &bufs) -> bool;
+
+  void StampPages(const std::vector<page_id_t> &pids, const std::vector<char *> &bufs) const;
+
+  /**
+   * @return false if a page has a mismatching checksum, which is logged
+   */
+  auto VerifyPages(file_id_t fid, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs) const -> bool;
+
+  /**
+   * Sort the pages by id and build one request for every run of adjacent pages
+   */
+  static auto BuildRequests(int fd, const std::vector<page_id_t> &pids, const std::vector<char *> &bufs,
+      bool is_write) -> std::vector<IORequest>;
+
+  static auto MakeFuture(bool is_write, file_id_t fid) -> std::pair<std::future<void>, IOEngine::Callback>;
+
+  // the engine starts its threads, so it is only created when async I/O is used for the first time
+  auto GetIOEngine() -> IOEngine &;
+
+private:
+  // protects the maps below, page I/O only needs the shared lock
+  mutable std::shared_mutex                  latch_;
   std::unordered_map<std::string, file_id_t> name_fid_map_;
   std::unordered_map<file_id_t, std::string> fid_name_map_;
+  // O_DIRECT descriptors of the files opened with direct_io, the file id is always the buffered descriptor
+  std::unordered_map<file_id_t, int> direct_fds_;
+
+  bool page_checksum_;
+
+  std::once_flag            io_engine_once_;
+  std::unique_ptr<IOEngine> io_engine_;
 };
 
 }  // namespace wsdb
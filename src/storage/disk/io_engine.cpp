@@ -0,0 +1,477 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#include "io_engine.h"
+
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "common/config.h"
+#include "../../../common/error.h"
+
+namespace wsdb {
+
+namespace {
+
+/**
+ * Shared completion state of a batch, the last finished request invokes the callback
+ */
+struct Batch
+{
+  Batch(size_t remaining, IOEngine::Callback cb) : remaining_(remaining), cb_(std::move(cb)) {}
+
+  void Finish(bool ok)
+  {
+    if (!ok) {
+      ok_.store(false, std::memory_order_relaxed);
+    }
+    if (remaining_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      if (cb_) {
+        cb_(ok_.load(std::memory_order_relaxed));
+      }
+      delete this;
+    }
+  }
+
+  std::atomic<size_t> remaining_;
+  std::atomic<bool>   ok_{true};
+  IOEngine::Callback  cb_;
+};
+
+auto TotalBytes(const IORequest &req) -> size_t
+{
+  size_t total = 0;
+  for (const auto &iov : req.iovs_) {
+    total += iov.iov_len;
+  }
+  return total;
+}
+
+/**
+ * Worker pool backend, each request of a batch is an independent task so one batch can be served by
+ * several workers in parallel
+ */
+class ThreadPoolIOEngine : public IOEngine
+{
+public:
+  explicit ThreadPoolIOEngine(size_t num_workers)
+  {
+    num_workers = std::max<size_t>(num_workers, 1);
+    for (size_t i = 0; i < num_workers; ++i) {
+      workers_.emplace_back([this] { Work(); });
+    }
+  }
+
+  ~ThreadPoolIOEngine() override
+  {
+    {
+      std::lock_guard lock(latch_);
+      stop_ = true;
+    }
+    cv_.notify_all();
+    for (auto &worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void Submit(std::vector<IORequest> reqs, Callback cb) override
+  {
+    if (reqs.empty()) {
+      if (cb) {
+        cb(true);
+      }
+      return;
+    }
+    auto batch = new Batch(reqs.size(), std::move(cb));
+    {
+      std::lock_guard lock(latch_);
+      for (auto &req : reqs) {
+        tasks_.emplace_back(std::move(req), batch);
+      }
+    }
+    cv_.notify_all();
+  }
+
+  [[nodiscard]] auto Name() const -> const char * override { return "ThreadPoolIOEngine"; }
+
+private:
+  void Work()
+  {
+    while (true) {
+      std::pair<IORequest, Batch *> task;
+      {
+        std::unique_lock lock(latch_);
+        cv_.wait(lock, [this] { return stop_ || !tasks_.empty(); });
+        // pending tasks are drained before exit so that no callback is lost
+        if (tasks_.empty()) {
+          return;
+        }
+        task = std::move(tasks_.front());
+        tasks_.pop_front();
+      }
+      task.second->Finish(ExecuteSync(task.first));
+    }
+  }
+
+  std::mutex                                latch_;
+  std::condition_variable                   cv_;
+  std::deque<std::pair<IORequest, Batch *>> tasks_;
+  std::vector<std::thread>                  workers_;
+  bool                                      stop_{false};
+};
+
+auto IOUringSetup(unsigned entries, io_uring_params *p) -> int
+{
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+auto IOUringEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) -> int
+{
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+/**
+ * io_uring backend driven by raw syscalls. Submitters fill the SQ under a latch, a reaper thread waits for
+ * completions. Short transfers (e.g. reads crossing EOF) and retryable errors are finished synchronously by
+ * the reaper. Callbacks run on the reaper, what they submit while the CQ is full is deferred instead of waiting.
+ */
+class IOUringEngine : public IOEngine
+{
+public:
+  static auto Make(unsigned entries) -> std::unique_ptr<IOUringEngine>
+  {
+    auto engine = std::unique_ptr<IOUringEngine>(new IOUringEngine());
+    if (!engine->Init(entries)) {
+      return nullptr;
+    }
+    engine->reaper_ = std::thread([e = engine.get()] { e->Reap(); });
+    return engine;
+  }
+
+  ~IOUringEngine() override
+  {
+    if (reaper_.joinable()) {
+      {
+        std::lock_guard lock(submit_latch_);
+        stop_.store(true);
+        // a nop with null user data wakes the reaper up
+        PushSqe(IORING_OP_NOP, -1, nullptr, 0, 0, 0);
+        SubmitPushed(1);
+      }
+      reaper_.join();
+    }
+    if (sqes_ != MAP_FAILED) {
+      munmap(sqes_, sqes_size_);
+    }
+    if (cq_ptr_ != MAP_FAILED && cq_ptr_ != sq_ptr_) {
+      munmap(cq_ptr_, cq_size_);
+    }
+    if (sq_ptr_ != MAP_FAILED) {
+      munmap(sq_ptr_, sq_size_);
+    }
+    if (ring_fd_ >= 0) {
+      close(ring_fd_);
+    }
+  }
+
+  void Submit(std::vector<IORequest> reqs, Callback cb) override
+  {
+    if (reqs.empty()) {
+      if (cb) {
+        cb(true);
+      }
+      return;
+    }
+    auto batch = new Batch(reqs.size(), std::move(cb));
+    // a callback submitting from the reaper must not wait for room, the reaper is the only thread that frees it
+    bool             from_reaper = std::this_thread::get_id() == reaper_.get_id();
+    std::unique_lock lock(submit_latch_);
+    for (auto &req : reqs) {
+      auto pending = new Pending{std::move(req), batch};
+      // never have more requests in flight than the completion queue can hold
+      if (inflight_ >= cq_entries_) {
+        if (from_reaper) {
+          deferred_.push_back(pending);
+          continue;
+        }
+        SubmitPushed(unsubmitted_);
+        space_cv_.wait(lock, [this] { return inflight_ < cq_entries_; });
+      }
+      Push(pending);
+    }
+    SubmitPushed(unsubmitted_);
+  }
+
+  [[nodiscard]] auto Name() const -> const char * override { return "IOUringEngine"; }
+
+private:
+  struct Pending
+  {
+    IORequest req_;
+    Batch    *batch_;
+  };
+
+  IOUringEngine() = default;
+
+  auto Init(unsigned entries) -> bool
+  {
+    io_uring_params params{};
+    ring_fd_ = IOUringSetup(entries, &params);
+    if (ring_fd_ < 0) {
+      return false;
+    }
+    sq_entries_ = params.sq_entries;
+    cq_entries_ = params.cq_entries;
+    sq_size_    = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size_    = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single) {
+      sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+    }
+    sq_ptr_ = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ptr_ == MAP_FAILED) {
+      return false;
+    }
+    cq_ptr_ = single ? sq_ptr_
+                     : mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                           IORING_OFF_CQ_RING);
+    if (cq_ptr_ == MAP_FAILED) {
+      return false;
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES);
+    if (sqes_ == MAP_FAILED) {
+      return false;
+    }
+    auto sq   = static_cast<char *>(sq_ptr_);
+    auto cq   = static_cast<char *>(cq_ptr_);
+    sq_head_  = reinterpret_cast<unsigned *>(sq + params.sq_off.head);
+    sq_tail_  = reinterpret_cast<unsigned *>(sq + params.sq_off.tail);
+    sq_mask_  = *reinterpret_cast<unsigned *>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params.sq_off.array);
+    cq_head_  = reinterpret_cast<unsigned *>(cq + params.cq_off.head);
+    cq_tail_  = reinterpret_cast<unsigned *>(cq + params.cq_off.tail);
+    cq_mask_  = *reinterpret_cast<unsigned *>(cq + params.cq_off.ring_mask);
+    cqes_     = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  /** must hold submit_latch_, the caller guarantees a free slot in the SQ */
+  void PushSqe(uint8_t opcode, int fd, const iovec *iovs, unsigned iov_num, uint64_t offset, uint64_t user_data)
+  {
+    unsigned tail = *sq_tail_;
+    unsigned idx  = tail & sq_mask_;
+    auto     sqe  = static_cast<io_uring_sqe *>(sqes_) + idx;
+    memset(sqe, 0, sizeof(io_uring_sqe));
+    sqe->opcode    = opcode;
+    sqe->fd        = fd;
+    sqe->addr      = reinterpret_cast<uint64_t>(iovs);
+    sqe->len       = iov_num;
+    sqe->off       = offset;
+    sqe->user_data = user_data;
+    sq_array_[idx] = idx;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+  }
+
+  /** must hold submit_latch_, the caller guarantees room for the request in the CQ */
+  void Push(Pending *pending)
+  {
+    PushSqe(pending->req_.is_write_ ? IORING_OP_WRITEV : IORING_OP_READV,
+        pending->req_.fd_,
+        pending->req_.iovs_.data(),
+        static_cast<unsigned>(pending->req_.iovs_.size()),
+        static_cast<uint64_t>(pending->req_.offset_),
+        reinterpret_cast<uint64_t>(pending));
+    inflight_++;
+    if (++unsubmitted_ == sq_entries_) {
+      SubmitPushed(unsubmitted_);
+    }
+  }
+
+  /** must hold submit_latch_ */
+  void SubmitPushed(unsigned num)
+  {
+    while (num > 0) {
+      int ret = IOUringEnter(ring_fd_, num, 0, 0);
+      if (ret < 0) {
+        if (errno == EINTR || errno == EAGAIN || errno == EBUSY) {
+          std::this_thread::yield();
+          continue;
+        }
+        WSDB_FETAL(fmt::format("io_uring_enter failed: {}", strerror(errno)));
+      }
+      num -= static_cast<unsigned>(ret);
+    }
+    unsubmitted_ = 0;
+  }
+
+  void Reap()
+  {
+    while (true) {
+      int ret = IOUringEnter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS);
+      if (ret < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+        WSDB_FETAL(fmt::format("io_uring_enter failed: {}", strerror(errno)));
+      }
+      unsigned head     = *cq_head_;
+      unsigned tail     = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      size_t   finished = 0;
+      for (; head != tail; ++head) {
+        const io_uring_cqe &cqe = cqes_[head & cq_mask_];
+        if (cqe.user_data != 0) {
+          Complete(reinterpret_cast<Pending *>(cqe.user_data), cqe.res);
+          finished++;
+        }
+      }
+      __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+      if (finished > 0) {
+        std::lock_guard lock(submit_latch_);
+        inflight_ -= finished;
+        // requests deferred by callbacks take the freed room first, waiting submitters get the rest
+        while (!deferred_.empty() && inflight_ < cq_entries_) {
+          Push(deferred_.front());
+          deferred_.pop_front();
+        }
+        SubmitPushed(unsubmitted_);
+        space_cv_.notify_all();
+      }
+      if (stop_.load()) {
+        std::lock_guard lock(submit_latch_);
+        if (inflight_ == 0 && deferred_.empty()) {
+          return;
+        }
+      }
+    }
+  }
+
+  static void Complete(Pending *pending, int res)
+  {
+    bool ok;
+    if (res >= 0 && static_cast<size_t>(res) == TotalBytes(pending->req_)) {
+      ok = true;
+    } else if (res >= 0) {
+      ok = ExecuteSync(pending->req_, static_cast<size_t>(res));
+    } else if (res == -EINTR || res == -EAGAIN) {
+      ok = ExecuteSync(pending->req_);
+    } else {
+      errno = -res;
+      ok    = false;
+    }
+    pending->batch_->Finish(ok);
+    delete pending;
+  }
+
+  int    ring_fd_{-1};
+  void  *sq_ptr_{MAP_FAILED};
+  void  *cq_ptr_{MAP_FAILED};
+  void  *sqes_{MAP_FAILED};
+  size_t sq_size_{0};
+  size_t cq_size_{0};
+  size_t sqes_size_{0};
+
+  unsigned     *sq_head_{nullptr};
+  unsigned     *sq_tail_{nullptr};
+  unsigned     *sq_array_{nullptr};
+  unsigned      sq_mask_{0};
+  unsigned      sq_entries_{0};
+  unsigned     *cq_head_{nullptr};
+  unsigned     *cq_tail_{nullptr};
+  io_uring_cqe *cqes_{nullptr};
+  unsigned      cq_mask_{0};
+  unsigned      cq_entries_{0};
+
+  std::mutex              submit_latch_;
+  std::condition_variable space_cv_;
+  unsigned                unsubmitted_{0};
+  size_t                  inflight_{0};
+  // requests submitted by callbacks while the CQ was full, pushed by the reaper once completions free room
+  std::deque<Pending *>   deferred_;
+  std::atomic<bool>       stop_{false};
+  std::thread             reaper_;
+};
+
+}  // namespace
+
+auto IOEngine::Create(size_t num_workers) -> std::unique_ptr<IOEngine>
+{
+  if (IO_ENGINE == "IOUringEngine") {
+    if (auto engine = IOUringEngine::Make(IO_URING_ENTRIES); engine != nullptr) {
+      return engine;
+    }
+    WSDB_LOG(fmt::format("io_uring is not available ({}), fall back to ThreadPoolIOEngine", strerror(errno)));
+  }
+  return std::make_unique<ThreadPoolIOEngine>(num_workers);
+}
+
+auto IOEngine::ExecuteSync(const IORequest &req, size_t done) -> bool
+{
+  size_t idx  = 0;
+  size_t skip = done;
+  while (idx < req.iovs_.size() && skip >= req.iovs_[idx].iov_len) {
+    skip -= req.iovs_[idx++].iov_len;
+  }
+  std::vector<iovec> iovs(req.iovs_.begin() + static_cast<long>(idx), req.iovs_.end());
+  size_t             first = 0;
+  if (!iovs.empty()) {
+    iovs[0].iov_base = static_cast<char *>(iovs[0].iov_base) + skip;
+    iovs[0].iov_len -= skip;
+  }
+  while (first < iovs.size()) {
+    auto    cnt = static_cast<int>(std::min<size_t>(iovs.size() - first, IOV_MAX));
+    off_t   off = req.offset_ + static_cast<off_t>(done);
+    ssize_t ret = req.is_write_ ? pwritev(req.fd_, iovs.data() + first, cnt, off)
+                                : preadv(req.fd_, iovs.data() + first, cnt, off);
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    if (ret == 0) {
+      if (req.is_write_) {
+        errno = EIO;
+        return false;
+      }
+      // EOF, pages that are not on disk yet read as zeros
+      for (size_t i = first; i < iovs.size(); ++i) {
+        memset(iovs[i].iov_base, 0, iovs[i].iov_len);
+      }
+      return true;
+    }
+    done += static_cast<size_t>(ret);
+    auto left = static_cast<size_t>(ret);
+    while (first < iovs.size() && left >= iovs[first].iov_len) {
+      left -= iovs[first++].iov_len;
+    }
+    if (left > 0) {
+      iovs[first].iov_base = static_cast<char *>(iovs[first].iov_base) + left;
+      iovs[first].iov_len -= left;
+    }
+  }
+  return true;
+}
+
+}  // namespace wsdb
@@ -0,0 +1,76 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#ifndef WSDB_IO_ENGINE_H
+#define WSDB_IO_ENGINE_H
+
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace wsdb {
+
+/**
+ * A vectored positional I/O request. Buffers referenced by iovs_ are owned by the caller
+ * and must stay valid until the completion callback of the batch is invoked.
+ */
+struct IORequest
+{
+  int                fd_{-1};
+  off_t              offset_{0};
+  bool               is_write_{false};
+  std::vector<iovec> iovs_;
+};
+
+/**
+ * IOEngine executes batches of page I/O asynchronously, the callback of a batch is invoked exactly once
+ * from an engine thread after every request of the batch has finished. A callback may submit more batches.
+ */
+class IOEngine
+{
+public:
+  using Callback = std::function<void(bool ok)>;
+
+  IOEngine()          = default;
+  virtual ~IOEngine() = default;
+
+  virtual void Submit(std::vector<IORequest> reqs, Callback cb) = 0;
+
+  [[nodiscard]] virtual auto Name() const -> const char * = 0;
+
+  /**
+   * Create the engine named by IO_ENGINE, io_uring falls back to the worker pool if the kernel
+   * (or a seccomp profile) does not allow it
+   * @param num_workers number of worker threads of the worker pool backend
+   */
+  static auto Create(size_t num_workers) -> std::unique_ptr<IOEngine>;
+
+  /**
+   * Execute a request synchronously with preadv/pwritev, short transfers are continued and EINTR is retried,
+   * reads beyond EOF are zero-filled
+   * @param req
+   * @param done number of bytes of the request that are already transferred
+   * @return true if succeeded
+   */
+  static auto ExecuteSync(const IORequest &req, size_t done = 0) -> bool;
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_IO_ENGINE_H
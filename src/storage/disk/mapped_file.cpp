@@ -0,0 +1,77 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#include "mapped_file.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include "checksum.h"
+#include "common/page.h"
+#include "../../../common/error.h"
+
+namespace wsdb {
+
+MappedFile::MappedFile(file_id_t fid, size_t page_num, bool verify_checksum)
+    : fid_(fid), page_num_(page_num), verify_checksum_(verify_checksum)
+{
+  if (page_num_ == 0) {
+    return;
+  }
+  void *data = mmap(nullptr, page_num_ * PAGE_SIZE, PROT_READ, MAP_SHARED, fid_, 0);
+  if (data == MAP_FAILED) {
+    WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("fid: {}, mmap {} pages, {}", fid_, page_num_, strerror(errno)));
+  }
+  data_ = static_cast<char *>(data);
+  // read ahead aggressively and let pages behind the scan go first
+  madvise(data_, page_num_ * PAGE_SIZE, MADV_SEQUENTIAL);
+  verified_ = std::make_unique<std::atomic<bool>[]>(page_num_);
+}
+
+MappedFile::~MappedFile()
+{
+  if (data_ != nullptr) {
+    munmap(data_, page_num_ * PAGE_SIZE);
+  }
+}
+
+auto MappedFile::GetPage(page_id_t pid) -> const char *
+{
+  if (pid < 0 || static_cast<size_t>(pid) >= page_num_) {
+    WSDB_THROW(WSDB_PAGE_MISS, fmt::format("fid: {}, page_id: {}, beyond the mapping", fid_, pid));
+  }
+  const char *page = data_ + static_cast<size_t>(pid) * PAGE_SIZE;
+  // racing readers may both verify the page, which is harmless
+  if (verify_checksum_ && pid != FILE_HEADER_PAGE_ID && !verified_[pid].load(std::memory_order_acquire)) {
+    if (!VerifyPageChecksum(page)) {
+      WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("fid: {}, page_id: {}, checksum mismatch", fid_, pid));
+    }
+    verified_[pid].store(true, std::memory_order_release);
+  }
+  return page;
+}
+
+void MappedFile::WillNeed(page_id_t first_pid, size_t count)
+{
+  if (first_pid < 0 || static_cast<size_t>(first_pid) >= page_num_) {
+    return;
+  }
+  count = std::min(count, page_num_ - static_cast<size_t>(first_pid));
+  madvise(data_ + static_cast<size_t>(first_pid) * PAGE_SIZE, count * PAGE_SIZE, MADV_WILLNEED);
+}
+
+}  // namespace wsdb
@@ -0,0 +1,71 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#ifndef WSDB_MAPPED_FILE_H
+#define WSDB_MAPPED_FILE_H
+
+#include <atomic>
+#include <memory>
+#include "common/types.h"
+#include "../../../common/micro.h"
+
+namespace wsdb {
+
+/**
+ * Read-only memory mapping of the pages of a file, the pages are read by the kernel on first touch and handed out
+ * in place, without a copy into the buffer pool. The mapping is advised sequential since mapped tables are meant for
+ * scans. Pages are checked against their checksums the first time they are handed out.
+ */
+class MappedFile
+{
+public:
+  /**
+   * Map pages [0, page_num) of the file
+   * @param verify_checksum verify the checksums of the pages, see DiskManager
+   */
+  MappedFile(file_id_t fid, size_t page_num, bool verify_checksum);
+
+  ~MappedFile();
+
+  DISABLE_COPY_MOVE_AND_ASSIGN(MappedFile)
+
+  /**
+   * @return data of the page, throws WSDB_PAGE_MISS beyond the mapping and WSDB_FILE_READ_ERROR on a checksum
+   * mismatch
+   */
+  auto GetPage(page_id_t pid) -> const char *;
+
+  /**
+   * Ask the kernel to read pages [first_pid, first_pid + count) ahead
+   */
+  void WillNeed(page_id_t first_pid, size_t count);
+
+  [[nodiscard]] auto GetPageNum() const -> size_t { return page_num_; }
+
+private:
+  file_id_t                          fid_;
+  size_t                             page_num_;
+  char                              *data_{nullptr};
+  bool                               verify_checksum_;
+  std::unique_ptr<std::atomic<bool>[]> verified_;
+};
+
+DEFINE_UNIQUE_PTR(MappedFile);
+
+}  // namespace wsdb
+
+#endif  // WSDB_MAPPED_FILE_H
@@ -0,0 +1,73 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#include "column_vector.h"
+#include <cstring>
+
+namespace wsdb {
+
+ColumnVector::ColumnVector(FieldType type, size_t width, size_t capacity)
+    : type_(type),
+      width_(width),
+      capacity_(capacity),
+      buffer_(std::make_shared<std::vector<char>>(width * capacity)),
+      data_(buffer_->data()),
+      validity_(std::make_shared<std::vector<char>>(BITMAP_SIZE(capacity)))
+{}
+
+auto ColumnVector::View(FieldType type, size_t width, const char *data, size_t size) -> ColumnVector
+{
+  ColumnVector col(type, width, 0);
+  col.capacity_ = size;
+  col.view_     = true;
+  col.size_     = size;
+  col.data_     = data;
+  col.validity_->resize(BITMAP_SIZE(size));
+  BitMap::Set(col.validity_->data(), size);
+  return col;
+}
+
+void ColumnVector::SetSize(size_t size)
+{
+  WSDB_ASSERT(size <= capacity_, fmt::format("size {} > capacity {}", size, capacity_));
+  size_ = size;
+}
+
+void ColumnVector::DetachBuffer()
+{
+  buffer_ = std::make_shared<std::vector<char>>(*buffer_);
+  data_   = buffer_->data();
+}
+
+void ColumnVector::DetachValidity() { validity_ = std::make_shared<std::vector<char>>(*validity_); }
+
+auto ColumnVector::GetString(size_t row) const -> std::string_view
+{
+  const char *str = data_ + row * width_;
+  return {str, strnlen(str, width_)};
+}
+
+auto ColumnVector::GetValue(size_t row) const -> ValueSptr
+{
+  WSDB_ASSERT(row < size_, fmt::format("row {} >= size {}", row, size_));
+  if (IsNull(row)) {
+    return ValueFactory::CreateNullValue(type_);
+  }
+  return ValueFactory::CreateValue(type_, data_ + row * width_, width_);
+}
+
+}  // namespace wsdb
@@ -0,0 +1,152 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#ifndef WSDB_COLUMN_VECTOR_H
+#define WSDB_COLUMN_VECTOR_H
+
+#include <memory>
+#include <string_view>
+#include <vector>
+#include "../../../common/micro.h"
+#include "common/bitmap.h"
+#include "common/value.h"
+
+namespace wsdb {
+
+/**
+ * Values of one column stored contiguously with a fixed width, int32_t, float and bool columns are flat arrays of
+ * the type and a string column is an array of width-byte buffers padded with '\0'. Nulls are kept in a separate
+ * validity bitmap whose bit is set for the rows that are not null, the value of a null row is undefined.
+ *
+ * A column either owns its values or is a read-only view of memory owned by someone else, e.g. the minipage of a
+ * mapped PAX page, in which case GetString returns views into that memory. The validity bitmap is always owned.
+ *
+ * Copies share the values and the validity bitmap, so copying a column, and slicing a chunk, is O(1) regardless of
+ * its size. A shared buffer is copied by the first write through a copy, i.e. GetMutableRawData, GetValidity or
+ * SetNull, which also invalidates the pointers previously returned by GetData of that copy
+ */
+class ColumnVector
+{
+public:
+  ColumnVector() = delete;
+
+  /**
+   * An empty column with room for capacity values of width bytes
+   */
+  ColumnVector(FieldType type, size_t width, size_t capacity);
+
+  /**
+   * A view of size values of width bytes at data, all of them valid, data must outlive the column and its copies
+   */
+  static auto View(FieldType type, size_t width, const char *data, size_t size) -> ColumnVector;
+
+  ColumnVector(const ColumnVector &other) = default;
+
+  ColumnVector(ColumnVector &&other) noexcept = default;
+
+  auto operator=(const ColumnVector &other) -> ColumnVector & = default;
+
+  auto operator=(ColumnVector &&other) noexcept -> ColumnVector & = default;
+
+  ~ColumnVector() = default;
+
+  [[nodiscard]] auto GetType() const -> FieldType { return type_; }
+
+  [[nodiscard]] auto GetWidth() const -> size_t { return width_; }
+
+  [[nodiscard]] auto GetSize() const -> size_t { return size_; }
+
+  [[nodiscard]] auto GetCapacity() const -> size_t { return capacity_; }
+
+  [[nodiscard]] auto IsView() const -> bool { return view_; }
+
+  void SetSize(size_t size);
+
+  /**
+   * Typed values, T must be the C++ type of the column, e.g. int32_t for TYPE_INT
+   */
+  template <typename T>
+  [[nodiscard]] auto GetData() const -> const T *
+  {
+    WSDB_ASSERT(sizeof(T) == width_, fmt::format("width {} != {}", sizeof(T), width_));
+    return reinterpret_cast<const T *>(data_);
+  }
+
+  [[nodiscard]] auto GetRawData() const -> const char * { return data_; }
+
+  /**
+   * Writable values of a column that owns them, views are read-only
+   */
+  template <typename T>
+  auto GetMutableData() -> T *
+  {
+    WSDB_ASSERT(sizeof(T) == width_, fmt::format("width {} != {}", sizeof(T), width_));
+    return reinterpret_cast<T *>(GetMutableRawData());
+  }
+
+  auto GetMutableRawData() -> char *
+  {
+    WSDB_ASSERT(!view_, "column is a read-only view");
+    if (buffer_.use_count() > 1) {
+      DetachBuffer();
+    }
+    return buffer_->data();
+  }
+
+  /**
+   * @return the string of a row without its '\0' padding, valid as long as the values of the column
+   */
+  [[nodiscard]] auto GetString(size_t row) const -> std::string_view;
+
+  auto GetValidity() -> char *
+  {
+    if (validity_.use_count() > 1) {
+      DetachValidity();
+    }
+    return validity_->data();
+  }
+
+  [[nodiscard]] auto IsNull(size_t row) const -> bool { return !BitMap::GetBit(validity_->data(), row); }
+
+  void SetNull(size_t row, bool is_null) { BitMap::SetBit(GetValidity(), row, !is_null); }
+
+  /**
+   * Box a row into a Value, for consumers that work on values
+   */
+  [[nodiscard]] auto GetValue(size_t row) const -> ValueSptr;
+
+private:
+  void DetachBuffer();
+
+  void DetachValidity();
+
+private:
+  FieldType         type_;
+  size_t            width_;
+  size_t            size_{0};
+  size_t            capacity_;
+  bool              view_{false};
+  std::shared_ptr<std::vector<char>> buffer_;  // the values if the column owns them, empty for a view
+  const char                        *data_;    // buffer_->data() or the viewed memory
+  std::shared_ptr<std::vector<char>> validity_;
+};
+
+DEFINE_UNIQUE_PTR(ColumnVector);
+
+}  // namespace wsdb
+
+#endif  // WSDB_COLUMN_VECTOR_H
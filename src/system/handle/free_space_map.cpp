@@ -0,0 +1,78 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#include "free_space_map.h"
+#include <algorithm>
+#include <cstring>
+#include "common/bitmap.h"
+
+namespace wsdb {
+
+FreeSpaceMap::FreeSpaceMap(size_t page_num) : page_num_(page_num), bitmap_(BITMAP_SIZE(page_num), 0) {}
+
+void FreeSpaceMap::Resize(size_t page_num)
+{
+  if (page_num > page_num_) {
+    page_num_ = page_num;
+    bitmap_.resize(BITMAP_SIZE(page_num_), 0);
+  }
+}
+
+void FreeSpaceMap::SetHasRoom(page_id_t pid, bool has_room)
+{
+  WSDB_ASSERT(pid >= 0 && static_cast<size_t>(pid) < page_num_, fmt::format("page_id: {}", pid));
+  BitMap::SetBit(bitmap_.data(), pid, has_room);
+  if (has_room) {
+    cursor_ = std::min(cursor_, static_cast<size_t>(pid));
+  }
+}
+
+auto FreeSpaceMap::HasRoom(page_id_t pid) const -> bool
+{
+  return pid >= 0 && static_cast<size_t>(pid) < page_num_ && BitMap::GetBit(bitmap_.data(), pid);
+}
+
+auto FreeSpaceMap::FindPageWithRoom() -> page_id_t
+{
+  cursor_ = BitMap::FindFirst(bitmap_.data(), page_num_, cursor_, true);
+  return cursor_ == page_num_ ? INVALID_PAGE_ID : static_cast<page_id_t>(cursor_);
+}
+
+auto FreeSpaceMap::Serialize() const -> std::vector<char>
+{
+  std::vector<char> data(sizeof(size_t) + bitmap_.size());
+  memcpy(data.data(), &page_num_, sizeof(size_t));
+  std::copy(bitmap_.begin(), bitmap_.end(), data.begin() + sizeof(size_t));
+  return data;
+}
+
+auto FreeSpaceMap::Deserialize(const char *data, size_t size) -> FreeSpaceMap
+{
+  size_t page_num;
+  if (size < sizeof(size_t)) {
+    return FreeSpaceMap();
+  }
+  memcpy(&page_num, data, sizeof(size_t));
+  if (page_num > (size - sizeof(size_t)) * BITMAP_WIDTH) {
+    return FreeSpaceMap();
+  }
+  FreeSpaceMap fsm(page_num);
+  memcpy(fsm.bitmap_.data(), data + sizeof(size_t), BITMAP_SIZE(page_num));
+  return fsm;
+}
+
+}  // namespace wsdb
@@ -0,0 +1,71 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#ifndef WSDB_FREE_SPACE_MAP_H
+#define WSDB_FREE_SPACE_MAP_H
+
+#include <vector>
+#include "common/types.h"
+
+namespace wsdb {
+
+/**
+ * Free space map of a table, one bit per page telling whether the page has an empty slot. The map is kept in the
+ * FSM_SUFFIX file next to the table file, laid out as
+ * | page_num (size_t) | bitmap of page_num bits |
+ */
+class FreeSpaceMap
+{
+public:
+  /**
+   * A map of page_num pages, none of which has room
+   */
+  explicit FreeSpaceMap(size_t page_num = 0);
+
+  /**
+   * Grow the map to page_num pages, the new pages have no room until SetHasRoom is called
+   */
+  void Resize(size_t page_num);
+
+  void SetHasRoom(page_id_t pid, bool has_room);
+
+  [[nodiscard]] auto HasRoom(page_id_t pid) const -> bool;
+
+  /**
+   * @return the lowest page that has room, INVALID_PAGE_ID if there is none. Pages below the cursor are known to be
+   * full, so a search only moves forward until a page gets room again and the lookup is amortized O(1)
+   */
+  auto FindPageWithRoom() -> page_id_t;
+
+  [[nodiscard]] auto GetPageNum() const -> size_t { return page_num_; }
+
+  [[nodiscard]] auto Serialize() const -> std::vector<char>;
+
+  /**
+   * @return the map, or an empty one if data does not hold a complete map
+   */
+  static auto Deserialize(const char *data, size_t size) -> FreeSpaceMap;
+
+private:
+  size_t            page_num_;
+  std::vector<char> bitmap_;
+  size_t            cursor_{0};
+};
+
+}  // namespace wsdb
+
+#endif  // WSDB_FREE_SPACE_MAP_H
@@ -35,7 +35,10 @@ void PageHandle::WriteSlot(size_t slot_id, const char *null_map, const char *dat
 }
 
 void PageHandle::ReadSlot(size_t slot_id, char *null_map, char *data) { WSDB_THROW(WSDB_EXCEPTION_EMPTY, ""); }
-auto PageHandle::ReadChunk(const RecordSchema *chunk_schema) -> ChunkUptr { WSDB_THROW(WSDB_EXCEPTION_EMPTY, ""); }
+auto PageHandle::ReadChunk([[maybe_unused]] const RecordSchema *chunk_schema, [[maybe_unused]] bool view) -> ChunkUptr
+{
+ WSDB_THROW(WSDB_EXCEPTION_EMPTY, "");
+}
 
 NAryPageHandle::NAryPageHandle(const TableHeader *tab_hdr, Page *page)
    : PageHandle(
@@ -133,56 +136,69 @@ void PAXPageHandle::ReadSlot(size_t slot_id, char *null_map, char *data)
 }
 /* ^__^ note FOR MYSELF: write and read */ /* if there's bugs afterwards CHECK */
 
-auto PAXPageHandle::ReadChunk(const RecordSchema *chunk_schema) -> ChunkUptr
+auto PAXPageHandle::ReadChunk(const RecordSchema *chunk_schema, bool view) -> ChunkUptr
 {
- std::vector<ArrayValueSptr> col_arrs;
- col_arrs.reserve(chunk_schema->GetFieldCount());
+ std::vector<ColumnVector> cols;
+ cols.reserve(chunk_schema->GetFieldCount());
 
- // read data each field and construct ArrayValue
+ // read data each field into a typed column, the minipage of a field is copied as is
  // WSDB_STUDENT_TODO(l1, f2);;
 
  // 获取每页的记录数
  size_t total_records = tab_hdr_->rec_per_page_;
+ size_t row_num       = BitMap::CountSet(bitmap_, total_records);
 
- // 定义一个 lambda 函数 processField，用于处理每个字段的读取和 ArrayValue 对象的构建
- auto processField = [&](size_t field_idx) -> ArrayValueSptr
+ for (size_t i = 0; i < chunk_schema->GetFieldCount(); ++i)
  {
-   const auto& field = chunk_schema->GetFieldAt(field_idx); // 获取字段的元数据
-   size_t field_size = field.field_.field_size_; // 字段数据的大小
-   size_t field_offset = offsets_[field_idx]; // 字段数据在记录中的偏移量
-   // 创建一个新的 ArrayValue 对象，用于存储该字段的所有值
-   auto array_value = std::make_shared<ArrayValue>();
-
-   // 遍历每个记录槽位
-   for (size_t slot_id = 0; slot_id < total_records; ++slot_id)
+   // the chunk may hold some of the fields of the table in any order
+   const auto& chunk_field = chunk_schema->GetFieldAt(i).field_;
+   size_t field_idx = schema_->GetFieldIndex(chunk_field.table_id_, chunk_field.field_name_);
+   if (field_idx == schema_->GetFieldCount())
    {
-     if (!BitMap::GetBit(bitmap_, slot_id)) continue;
-
-     // 获取字段的 null_map 位的指针
-     char* null_map_ptr = slots_mem_ + slot_id * tab_hdr_->nullmap_size_;
-     if (BitMap::GetBit(null_map_ptr, field_idx))
+     WSDB_THROW(WSDB_FIELD_MISS, chunk_field.field_name_);
+   }
+   const auto& field = schema_->GetFieldAt(field_idx).field_; // 获取字段的元数据
+   size_t field_size = field.field_size_; // 字段数据的大小
+   const char* minipage = slots_mem_ + offsets_[field_idx]; // 该字段所有槽位的数据
+   if (view)
+   {
+     // 直接引用页内的数据, one row per slot, the empty slots are left out by the selection
+     auto col = ColumnVector::View(field.field_type_, field_size, minipage, total_records);
+     BitMap::ForEachSet(bitmap_, total_records, [&](size_t slot_id)
      {
-       // 追加一个 null 值到 array_value
-       array_value->Append(ValueFactory::CreateNullValue(field.field_.field_type_));
-     }
-     else
+       col.SetNull(slot_id, BitMap::GetBit(slots_mem_ + slot_id * tab_hdr_->nullmap_size_, field_idx));
+     });
+     cols.push_back(std::move(col));
+     continue;
+   }
+   ColumnVector col(field.field_type_, field_size, row_num);
+
+   // 按连续的已占用槽位分段拷贝, a full page takes a single memcpy
+   size_t row = 0;
+   size_t begin = BitMap::FindFirst(bitmap_, total_records, 0, true);
+   while (begin < total_records)
+   {
+     size_t end = BitMap::FindFirst(bitmap_, total_records, begin, false);
+     memcpy(col.GetMutableRawData() + row * field_size, minipage + begin * field_size, (end - begin) * field_size);
+     for (size_t slot_id = begin; slot_id < end; ++slot_id, ++row)
      {
-       // 计算字段数据的位置，并读取数据
-       char* field_data = slots_mem_ + field_offset + slot_id * field_size;
-       // 创建字段值，并追加到 array_value
-       auto value = ValueFactory::CreateValue(field.field_.field_type_, field_data, field_size);
-       array_value->Append(value);
+       // 字段的 null_map 位
+       col.SetNull(row, BitMap::GetBit(slots_mem_ + slot_id * tab_hdr_->nullmap_size_, field_idx));
      }
+     begin = BitMap::FindFirst(bitmap_, total_records, end, true);
    }
-   return array_value;
- };
+   col.SetSize(row_num);
+   cols.push_back(std::move(col));
+ }
 
- // 对于 chunk_schema 中的每个字段，调用 processField 并存储结果
- for (size_t field_idx = 0; field_idx < chunk_schema->GetFieldCount(); ++field_idx)
+ auto chunk = std::make_unique<Chunk>(chunk_schema, std::move(cols));
+ if (view && row_num < total_records)
  {
-   col_arrs.push_back(processField(field_idx));
+   std::vector<uint32_t> selection;
+   selection.reserve(row_num);
+   BitMap::ForEachSet(bitmap_, total_records, [&](size_t slot_id) { selection.push_back(slot_id); });
+   chunk->SetSelection(std::move(selection));
  }
-
- return std::make_unique<Chunk>(chunk_schema, std::move(col_arrs));
+ return chunk;
 }
 }  // namespace wsdb
\ No newline at end of file
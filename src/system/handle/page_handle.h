@@ -45,7 +45,13 @@ public:
 
  virtual void ReadSlot(size_t slot_id, char *null_map, char *data);
 
- virtual auto ReadChunk(const RecordSchema *chunk_schema) -> ChunkUptr;
+ /**
+  * Read the fields of chunk_schema of all records in the page
+  * @param chunk_schema
+  * @param view make the columns views of the page instead of copies, with the occupied slots as the selection,
+  * only if the page memory outlives the chunk, e.g. a page of a mapped table
+  */
+ virtual auto ReadChunk(const RecordSchema *chunk_schema, bool view) -> ChunkUptr;
 
  virtual ~PageHandle() = default;
 
@@ -96,7 +102,7 @@ public:
 
  void ReadSlot(size_t slot_id, char *null_map, char *data) override;
 
- auto ReadChunk(const RecordSchema *chunk_schema) -> ChunkUptr override;
+ auto ReadChunk(const RecordSchema *chunk_schema, bool view) -> ChunkUptr override;
 
 private:
  const RecordSchema        *schema_;
@@ -20,6 +20,7 @@
 //
 
 #include "record_handle.h"
+#include <algorithm>
 #include <cstring>
 #include <utility>
 
@@ -257,6 +258,8 @@ Record &Record::operator=(const Record &record)
   if (this == &record) {
     return *this;
   }
+  delete[] data_;
+  delete[] nullmap_;
   schema_  = record.schema_;
   data_    = new char[schema_->GetRecordLength()];
   nullmap_ = new char[BITMAP_SIZE(schema_->GetFieldCount())];
@@ -327,16 +330,7 @@ auto Record::Hash() const -> size_t
   return hash;
 }
 
-auto Record::GetValueAt(size_t index) const -> ValueSptr
-{
-  WSDB_ASSERT(index < schema_->GetFieldCount(), "Index out of range");
-  auto &field = schema_->GetFieldAt(index);
-  if (BitMap::GetBit(nullmap_, index)) {
-    return ValueFactory::CreateNullValue(field.field_.field_type_);
-  }
-  return ValueFactory::CreateValue(
-      field.field_.field_type_, data_ + schema_->offsets_[index], field.field_.field_size_);
-}
+auto Record::GetValueAt(size_t index) const -> ValueSptr { return RecordView(*this).GetValueAt(index); }
 
 auto Record::Compare(const wsdb::Record &lrec, const wsdb::Record &rrec) -> int
 {
@@ -363,9 +357,24 @@ auto Record::Compare(const wsdb::Record &lrec, const wsdb::Record &rrec) -> int
   return 0;
 }
 
-Chunk::Chunk(const RecordSchema *schema, std::vector<ArrayValueSptr> cols) : schema_(schema), cols_(std::move(cols))
+auto RecordView::GetValueAt(size_t index) const -> ValueSptr
+{
+  WSDB_ASSERT(index < schema_->GetFieldCount(), "Index out of range");
+  auto &field = schema_->GetFieldAt(index);
+  if (BitMap::GetBit(nullmap_, index)) {
+    return ValueFactory::CreateNullValue(field.field_.field_type_);
+  }
+  return ValueFactory::CreateValue(field.field_.field_type_, GetFieldData(index), field.field_.field_size_);
+}
+
+auto RecordView::ToRecord() const -> RecordUptr { return std::make_unique<Record>(schema_, nullmap_, data_, rid_); }
+
+Chunk::Chunk(const RecordSchema *schema, std::vector<ColumnVector> cols) : schema_(schema), cols_(std::move(cols))
 {
   WSDB_ASSERT(schema_->GetFieldCount() == cols_.size(), "Field count mismatch");
+  for (const auto &col : cols_) {
+    WSDB_ASSERT(col.GetSize() == cols_.front().GetSize(), "Column size mismatch");
+  }
 }
 
 Chunk::~Chunk() = default;
@@ -378,7 +387,108 @@ Chunk &Chunk::operator=(const wsdb::Chunk &chunk) = default;
 
 Chunk &Chunk::operator=(wsdb::Chunk &&chunk) noexcept = default;
 
-auto Chunk::GetCol(int index) -> ArrayValueSptr { return cols_[index]; }
+auto Chunk::GetCol(size_t index) -> ColumnVector & { return cols_[index]; }
+
+auto Chunk::GetCol(size_t index) const -> const ColumnVector & { return cols_[index]; }
+
+auto Chunk::GetColCount() const -> size_t { return cols_.size(); }
+
+auto Chunk::GetSize() const -> size_t
+{
+  if (has_selection_) {
+    return selection_.size();
+  }
+  return cols_.empty() ? 0 : cols_.front().GetSize();
+}
 
-auto Chunk::GetColCount() -> size_t { return cols_.size(); }
+void Chunk::SetSelection(std::vector<uint32_t> selection)
+{
+  selection_     = std::move(selection);
+  has_selection_ = true;
+}
+
+void Chunk::ClearSelection()
+{
+  selection_.clear();
+  has_selection_ = false;
+}
+
+auto Chunk::GetValue(size_t col, size_t row) const -> ValueSptr { return cols_[col].GetValue(GetRowIndex(row)); }
+
+auto Chunk::Slice(size_t offset, size_t count) const -> ChunkUptr
+{
+  WSDB_ASSERT(offset + count <= GetSize(), fmt::format("slice [{}, {}) of {} rows", offset, offset + count, GetSize()));
+  std::vector<uint32_t> selection(count);
+  for (size_t row = 0; row < count; ++row) {
+    selection[row] = static_cast<uint32_t>(GetRowIndex(offset + row));
+  }
+  // the copy shares the values of the columns, see ColumnVector
+  auto chunk = std::make_unique<Chunk>(*this);
+  chunk->SetSelection(std::move(selection));
+  return chunk;
+}
+
+void Chunk::GatherRow(size_t row, char *nullmap, char *data) const
+{
+  auto idx = GetRowIndex(row);
+  for (size_t i = 0; i < cols_.size(); ++i) {
+    const auto &col = cols_[i];
+    if (col.IsNull(idx)) {
+      BitMap::SetBit(nullmap, i, true);
+      continue;
+    }
+    auto size = std::min(col.GetWidth(), schema_->GetFieldAt(i).field_.field_size_);
+    memcpy(data + schema_->GetFieldOffset(i), col.GetRawData() + idx * col.GetWidth(), size);
+  }
+}
+
+auto Chunk::GetRecord(size_t row) const -> RecordUptr
+{
+  auto nullmap = std::vector<char>(BITMAP_SIZE(schema_->GetFieldCount()), 0);
+  auto data    = std::vector<char>(schema_->GetRecordLength(), 0);
+  GatherRow(row, nullmap.data(), data.data());
+  return std::make_unique<Record>(schema_, nullmap.data(), data.data(), INVALID_RID);
+}
+
+auto Chunk::GetRecordView(size_t row, Arena &arena) const -> RecordView
+{
+  auto nullmap_size = BITMAP_SIZE(schema_->GetFieldCount());
+  auto nullmap      = arena.Allocate(nullmap_size, 1);
+  auto data         = arena.Allocate(schema_->GetRecordLength());
+  memset(nullmap, 0, nullmap_size);
+  memset(data, 0, schema_->GetRecordLength());
+  GatherRow(row, nullmap, data);
+  return {schema_, nullmap, data, INVALID_RID};
+}
+
+auto Chunk::FromRecords(const RecordSchema *schema, const std::vector<RecordUptr> &records) -> ChunkUptr
+{
+  std::vector<RecordView> views;
+  views.reserve(records.size());
+  for (const auto &record : records) {
+    views.emplace_back(*record);
+  }
+  return FromRecords(schema, views);
+}
+
+auto Chunk::FromRecords(const RecordSchema *schema, const std::vector<RecordView> &records) -> ChunkUptr
+{
+  std::vector<ColumnVector> cols;
+  cols.reserve(schema->GetFieldCount());
+  for (size_t i = 0; i < schema->GetFieldCount(); ++i) {
+    const auto &field  = schema->GetFieldAt(i).field_;
+    auto        offset = schema->GetFieldOffset(i);
+    ColumnVector col(field.field_type_, field.field_size_, records.size());
+    for (size_t row = 0; row < records.size(); ++row) {
+      bool is_null = records[row].IsNull(i);
+      col.SetNull(row, is_null);
+      if (!is_null) {
+        memcpy(col.GetMutableRawData() + row * field.field_size_, records[row].GetData() + offset, field.field_size_);
+      }
+    }
+    col.SetSize(records.size());
+    cols.push_back(std::move(col));
+  }
+  return std::make_unique<Chunk>(schema, std::move(cols));
+}
 }  // namespace wsdb
\ No newline at end of file
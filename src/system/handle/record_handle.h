@@ -26,7 +26,9 @@
 #include "common/meta.h"
 #include "common/rid.h"
 #include "common/value.h"
+#include "common/arena.h"
 #include "common/bitmap.h"
+#include "column_vector.h"
 
 namespace wsdb {
 
@@ -181,12 +183,67 @@ private:
   RID                 rid_{};
 };
 
+/**
+ * A record that does not own its memory, e.g. a record in an Arena or another Record, for rows that are passed along
+ * without being copied. The view is valid as long as the memory it points to, a default constructed view is invalid
+ */
+class RecordView
+{
+public:
+  RecordView() = default;
+
+  RecordView(const RecordSchema *schema, const char *null_map_mem, const char *data, RID rid)
+      : schema_(schema), nullmap_(null_map_mem), data_(data), rid_(rid)
+  {}
+
+  explicit RecordView(const Record &record)
+      : schema_(record.GetSchema()), nullmap_(record.GetNullMap()), data_(record.GetData()), rid_(record.GetRID())
+  {}
+
+  [[nodiscard]] auto IsValid() const -> bool { return schema_ != nullptr; }
+
+  [[nodiscard]] auto GetRID() const -> RID { return rid_; }
+
+  [[nodiscard]] auto GetSchema() const -> const RecordSchema * { return schema_; }
+
+  [[nodiscard]] auto GetData() const -> const char * { return data_; }
+
+  [[nodiscard]] auto GetNullMap() const -> const char * { return nullmap_; }
+
+  [[nodiscard]] auto IsNull(size_t index) const -> bool { return BitMap::GetBit(nullmap_, index); }
+
+  /**
+   * @return raw value of a field, undefined if it is null
+   */
+  [[nodiscard]] auto GetFieldData(size_t index) const -> const char * { return data_ + schema_->GetFieldOffset(index); }
+
+  [[nodiscard]] auto GetValueAt(size_t index) const -> ValueSptr;
+
+  /**
+   * Copy the viewed record into a record of its own
+   */
+  [[nodiscard]] auto ToRecord() const -> RecordUptr;
+
+private:
+  const RecordSchema *schema_{nullptr};
+  const char         *nullmap_{nullptr};
+  const char         *data_{nullptr};
+  RID                 rid_{};
+};
+
+/**
+ * A batch of rows of the same schema stored column by column. A selection vector picks the rows of the columns that
+ * make up the chunk, so that e.g. a filter drops rows without moving any value
+ */
 class Chunk
 {
 public:
   Chunk() = delete;
 
-  Chunk(const RecordSchema *schema, std::vector<ArrayValueSptr> cols);
+  /**
+   * @param cols one column per field of the schema, all of the same size
+   */
+  Chunk(const RecordSchema *schema, std::vector<ColumnVector> cols);
 
   ~Chunk();
 
@@ -198,13 +255,70 @@ public:
 
   Chunk &operator=(Chunk &&chunk) noexcept;
 
-  auto GetCol(int index) -> ArrayValueSptr;
+  [[nodiscard]] auto GetSchema() const -> const RecordSchema * { return schema_; }
+
+  auto GetCol(size_t index) -> ColumnVector &;
+
+  [[nodiscard]] auto GetCol(size_t index) const -> const ColumnVector &;
+
+  [[nodiscard]] auto GetColCount() const -> size_t;
+
+  /**
+   * @return number of rows, the selected ones if there is a selection
+   */
+  [[nodiscard]] auto GetSize() const -> size_t;
+
+  /**
+   * Keep only the rows of the columns at the given indexes, in that order
+   */
+  void SetSelection(std::vector<uint32_t> selection);
+
+  void ClearSelection();
+
+  [[nodiscard]] auto HasSelection() const -> bool { return has_selection_; }
+
+  [[nodiscard]] auto GetSelection() const -> const std::vector<uint32_t> & { return selection_; }
+
+  /**
+   * @return index in the columns of the row-th row of the chunk
+   */
+  [[nodiscard]] auto GetRowIndex(size_t row) const -> size_t { return has_selection_ ? selection_[row] : row; }
+
+  [[nodiscard]] auto GetValue(size_t col, size_t row) const -> ValueSptr;
 
-  auto GetColCount() -> size_t;
+  /**
+   * Rows [offset, offset + count) of the chunk, a chunk sharing the columns with a selection of those rows
+   */
+  [[nodiscard]] auto Slice(size_t offset, size_t count) const -> ChunkUptr;
+
+  /**
+   * Copy the row-th row of the chunk into a record of the chunk schema, for the row-based executors
+   */
+  [[nodiscard]] auto GetRecord(size_t row) const -> RecordUptr;
+
+  /**
+   * Same as GetRecord with the row gathered into the arena, valid until the arena is reset
+   */
+  [[nodiscard]] auto GetRecordView(size_t row, Arena &arena) const -> RecordView;
+
+  /**
+   * Copy records of the schema into a chunk of owning columns, without a selection
+   */
+  static auto FromRecords(const RecordSchema *schema, const std::vector<RecordUptr> &records) -> ChunkUptr;
+
+  static auto FromRecords(const RecordSchema *schema, const std::vector<RecordView> &records) -> ChunkUptr;
+
+private:
+  /**
+   * Write the row-th row into a null map and a record of the chunk schema, which are zeroed beforehand
+   */
+  void GatherRow(size_t row, char *nullmap, char *data) const;
 
 private:
-  const RecordSchema         *schema_;
-  std::vector<ArrayValueSptr> cols_;
+  const RecordSchema       *schema_;
+  std::vector<ColumnVector> cols_;
+  bool                      has_selection_{false};
+  std::vector<uint32_t>     selection_;
 };
 
 }  // namespace wsdb
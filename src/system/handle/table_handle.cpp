@@ -23,13 +23,15 @@
 namespace wsdb {
 
 TableHandle::TableHandle(DiskManager* disk_manager, BufferPoolManager* buffer_pool_manager, table_id_t table_id,
-   TableHeader& hdr, RecordSchemaUptr& schema, StorageModel storage_model)
+   TableHeader& hdr, RecordSchemaUptr& schema, StorageModel storage_model, FreeSpaceMap fsm, MappedFileUptr mapped)
    : tab_hdr_(hdr),
      table_id_(table_id),
      disk_manager_(disk_manager),
      buffer_pool_manager_(buffer_pool_manager),
      schema_(std::move(schema)),
-     storage_model_(storage_model)
+     storage_model_(storage_model),
+     fsm_(std::move(fsm)),
+     mapped_(std::move(mapped))
 {
  // set table id for table handle;
  schema_->SetTableId(table_id_);
@@ -46,93 +48,122 @@ TableHandle::TableHandle(DiskManager* disk_manager, BufferPoolManager* buffer_po
      offSet += fieldSize * tab_hdr_.rec_per_page_; // 更新偏移量，跳过当前字段的所有记录
    }
  }
+ // mapped tables are never inserted into
+ if (mapped_ == nullptr && fsm_.GetPageNum() != tab_hdr_.page_num_) {
+   RebuildFreeSpaceMap();
+ }
+ // preallocated pages past page_num_ are zeros on disk, read-ahead stops before them
+ if (mapped_ == nullptr) {
+   buffer_pool_manager_->SetReadAheadLimit(table_id_, tab_hdr_.page_num_);
+ }
 }
 
-auto TableHandle::GetRecord(const RID& rid) -> RecordUptr
+auto TableHandle::GetRecord(const RID& rid, BufferAccessStrategy* strategy) -> RecordUptr
 {
   auto nullmap = std::make_unique<char[]>(tab_hdr_.nullmap_size_);
   auto data = std::make_unique<char[]>(tab_hdr_.rec_size_);
   // WSDB_STUDENT_TODO(l1, t3);
-  auto page_handle = FetchPageHandle(rid.PageID());
-
-  auto bitMap = page_handle->GetBitmap();
-  // No record in the slot
-  if (!BitMap::GetBit(bitMap, rid.SlotID()))
-  {
-    buffer_pool_manager_->UnpinPage(table_id_, rid.PageID(), false);
-    WSDB_THROW(WSDB_PAGE_MISS, fmt::format("Page: {}", rid.PageID()));
-  }
-  else
-  {
-    page_handle->ReadSlot(rid.SlotID(), nullmap.get(), data.get());
-    buffer_pool_manager_->UnpinPage(table_id_, rid.PageID(), false);
-    return std::make_unique<Record>(schema_.get(), nullmap.get(), data.get(), rid);
-  }
+  VisitPage(rid.PageID(), strategy, [&](PageHandle& page_handle) {
+    auto bitMap = page_handle.GetBitmap();
+    // No record in the slot
+    if (!BitMap::GetBit(bitMap, rid.SlotID()))
+    {
+      WSDB_THROW(WSDB_PAGE_MISS, fmt::format("Page: {}", rid.PageID()));
+    }
+    page_handle.ReadSlot(rid.SlotID(), nullmap.get(), data.get());
+  });
+  return std::make_unique<Record>(schema_.get(), nullmap.get(), data.get(), rid);
 }
 
-auto TableHandle::GetChunk(page_id_t pid, const RecordSchema* chunk_schema) -> ChunkUptr
+auto TableHandle::GetChunk(page_id_t pid, const RecordSchema* chunk_schema, BufferAccessStrategy* strategy) -> ChunkUptr
 {
   // WSDB_STUDENT_TODO(l1, f2);
-  // 获取页面句柄
-  auto page_handle = FetchPageHandle(pid);
-  // 使用页面句柄读取数据块（Chunk）
-  auto chunk = page_handle->ReadChunk(chunk_schema); // 根据传入的chunk_schema来解析数据
-  // 读取完成后，将页面从缓冲池中解除固定（不再需要此页面）
-  buffer_pool_manager_->UnpinPage(table_id_, pid, false);
-  return chunk; // 返回读取的数据块
+  // 获取页面句柄, the page is unpinned once the chunk is read
+  return VisitPage(pid, strategy, [&](PageHandle& page_handle) {
+    // 使用页面句柄读取数据块（Chunk）
+    // pages of a mapped table stay in memory as long as the table, so the chunk can point into them
+    return page_handle.ReadChunk(chunk_schema, mapped_ != nullptr); // 根据传入的chunk_schema来解析数据
+  });
 }
 
-auto TableHandle::InsertRecord(const Record& record) -> RID
+void TableHandle::GetPageRecords(
+    page_id_t pid, Arena& arena, std::vector<RecordView>& records, BufferAccessStrategy* strategy)
 {
-  // WSDB_STUDENT_TODO(l1, t3);
-
-  // 1. create a page handle using CreatePageHandle
-  auto new_page_handle = CreateNewPageHandle();
-
-  // 2. get an empty slot in the page
-  auto bitMap = new_page_handle->GetBitmap();
-  auto empty_slot = BitMap::FindFirst(bitMap, tab_hdr_.rec_per_page_, 0, false);
-
-  // 3. write the record into the slot
-  new_page_handle->WriteSlot(empty_slot, record.GetNullMap(), record.GetData(), false);
+  records.clear();
+  VisitPage(pid, strategy, [&](PageHandle& page_handle) {
+    BitMap::ForEachSet(page_handle.GetBitmap(), tab_hdr_.rec_per_page_, [&](size_t slot_id) {
+      auto nullmap = arena.Allocate(tab_hdr_.nullmap_size_, 1);
+      auto data    = arena.Allocate(tab_hdr_.rec_size_);
+      page_handle.ReadSlot(slot_id, nullmap, data);
+      records.emplace_back(schema_.get(), nullmap, data, RID(pid, static_cast<slot_id_t>(slot_id)));
+    });
+  });
+}
 
-  // 4. update the bitmap and the number of records in the page header
-  BitMap::SetBit(bitMap, empty_slot, true); // slot已占用
-  tab_hdr_.rec_num_++; // 全局记录计数递增：增加表级的总记录数
-  auto recordNum = new_page_handle->GetPage()->GetRecordNum(); // 获取该页当前记录的数量
-  new_page_handle->GetPage()->SetRecordNum(recordNum++); // 将页内记录数自增并更新到当前页
+auto TableHandle::InsertRecord(const Record& record, BufferAccessStrategy* strategy) -> RID
+{
+  // WSDB_STUDENT_TODO(l1, t3);
+  CheckWritable();
 
-  // 5. if the page is full after inserting the record
-  if(recordNum == tab_hdr_.rec_per_page_)
+  while (true)
   {
-    // update the first free page id in the file header
-    tab_hdr_.first_free_page_ = new_page_handle->GetPage()->GetNextFreePageId(); // 指向下一个空闲页
-    // set the next page id of the current page
-    new_page_handle->GetPage()->SetNextFreePageId(INVALID_PAGE_ID); // 标记此页不再是空闲页，表示不可插入
+    // 1. create a page handle using CreatePage
+    auto guard           = CreatePage(strategy);
+    auto new_page_handle = WrapPageHandle(guard);
+
+    // 2. get an empty slot in the page, the free space map may be stale, e.g. after a crash or when another
+    // insert filled the page first, then the page is marked full and the next one is tried
+    auto bitMap = new_page_handle->GetBitmap();
+    auto empty_slot = BitMap::FindFirst(bitMap, tab_hdr_.rec_per_page_, 0, false);
+    if (empty_slot == tab_hdr_.rec_per_page_)
+    {
+      std::scoped_lock lock(latch_);
+      fsm_.SetHasRoom(guard.GetPageId(), false);
+      continue;
+    }
+
+    // 3. write the record into the slot
+    new_page_handle->WriteSlot(empty_slot, record.GetNullMap(), record.GetData(), false);
+
+    // 4. update the bitmap and the number of records in the page header
+    BitMap::SetBit(bitMap, empty_slot, true); // slot已占用
+    auto recordNum = new_page_handle->GetPage()->GetRecordNum(); // 获取该页当前记录的数量
+    new_page_handle->GetPage()->SetRecordNum(++recordNum); // 将页内记录数自增并更新到当前页
+
+    std::scoped_lock lock(latch_);
+    tab_hdr_.rec_num_++; // 全局记录计数递增：增加表级的总记录数
+    // 5. if the page is full after inserting the record, slots before empty_slot are taken already
+    if (BitMap::FindFirst(bitMap, tab_hdr_.rec_per_page_, empty_slot + 1, false) == tab_hdr_.rec_per_page_)
+    {
+      fsm_.SetHasRoom(guard.GetPageId(), false); // 标记此页不再是空闲页，表示不可插入
+    }
+
+    // 6. the guard unpins the page
+
+    // @param record
+    // @return rid of the inserted record
+    return RID(guard.GetPageId(), empty_slot);
   }
-
-  // 6. unpin the page
-  buffer_pool_manager_->UnpinPage(table_id_, new_page_handle->GetPage()->GetPageId(), true);
-
-  // @param record
-  // @return rid of the inserted record
-  return RID(new_page_handle->GetPage()->GetPageId(), empty_slot);
 }
 
 void TableHandle::InsertRecord(const RID& rid, const Record& record)
 {
- if (rid.PageID() == INVALID_PAGE_ID) {
-   WSDB_THROW(WSDB_PAGE_MISS, fmt::format("Page: {}", rid.PageID()));
+ CheckWritable();
+ {
+   std::scoped_lock lock(latch_);
+   if (rid.PageID() <= FILE_HEADER_PAGE_ID || static_cast<size_t>(rid.PageID()) >= tab_hdr_.page_num_) {
+     WSDB_THROW(WSDB_PAGE_MISS, fmt::format("Page: {}", rid.PageID()));
+   }
  }
  // WSDB_STUDENT_TODO(l1, t3);
 
  // 2. fetch the page handle and check the bitmap
- auto new_page_handle = FetchPageHandle(rid.PageID());
+ auto guard           = buffer_pool_manager_->FetchPageWrite(table_id_, rid.PageID());
+ auto new_page_handle = WrapPageHandle(guard);
  auto bitMap = new_page_handle->GetBitmap();
  // if the slot is not empty, throw WSDB_RECORD_EXISTS
  if (BitMap::GetBit(bitMap, rid.SlotID()))
  {
-   buffer_pool_manager_->UnpinPage(table_id_, rid.PageID(), false);
    WSDB_THROW(WSDB_RECORD_EXISTS, fmt::format("Record: {}", rid.SlotID()));
  }
 
@@ -142,107 +173,132 @@ void TableHandle::InsertRecord(const RID& rid, const Record& record)
 
  // 4. update the bitmap and the number of records in the page header
  BitMap::SetBit(bitMap, rid.SlotID(), true); // slot已占用
- tab_hdr_.rec_num_++; // 全局记录计数递增：增加表级的总记录数
  auto recordNum = new_page_handle->GetPage()->GetRecordNum(); // 获取该页当前记录的数量
- new_page_handle->GetPage()->SetRecordNum(recordNum++); // 将页内记录数自增并更新到当前页
+ new_page_handle->GetPage()->SetRecordNum(++recordNum); // 将页内记录数自增并更新到当前页
 
+ std::scoped_lock lock(latch_);
+ tab_hdr_.rec_num_++; // 全局记录计数递增：增加表级的总记录数
  // 5. if the page is full after inserting the record
- if(recordNum == tab_hdr_.rec_per_page_)
+ if (BitMap::FindFirst(bitMap, tab_hdr_.rec_per_page_, 0, false) == tab_hdr_.rec_per_page_)
  {
-   // update the first free page id in the file header
-   tab_hdr_.first_free_page_ = new_page_handle->GetPage()->GetNextFreePageId(); // 指向下一个空闲页
-   // set the next page id of the current page
-   new_page_handle->GetPage()->SetNextFreePageId(INVALID_PAGE_ID); // 标记此页不再是空闲页，表示不可插入
+   fsm_.SetHasRoom(rid.PageID(), false); // 标记此页不再是空闲页，表示不可插入
  }
 
- // 6. unpin the page
- buffer_pool_manager_->UnpinPage(table_id_, new_page_handle->GetPage()->GetPageId(), true);
+ // 6. the guard unpins the page
 }
 
 void TableHandle::DeleteRecord(const RID& rid)
 {
   // WSDB_STUDENT_TODO(l1, t3);
+  CheckWritable();
 
-  auto page_handle = FetchPageHandle(rid.PageID());
+  auto guard       = buffer_pool_manager_->FetchPageWrite(table_id_, rid.PageID());
+  auto page_handle = WrapPageHandle(guard);
   auto bitMap = page_handle->GetBitmap();
 
-  // 1. if the slot is empty
+  // 1. if the slot is empty, throw WSDB_RECORD_MISS
   if (!BitMap::GetBit(bitMap, rid.SlotID()))
   {
-    // unpin the page
-    buffer_pool_manager_->UnpinPage(table_id_, rid.PageID(), false);
-    // throw WSDB_RECORD_MISS
     WSDB_THROW(WSDB_RECORD_MISS, fmt::format("Record: {}", rid.SlotID()));
   }
 
   // 2. update the bitmap and the number of records in the page header
   BitMap::SetBit(bitMap, rid.SlotID(), false); // slot未占用 // 和上面的倒反
-  tab_hdr_.rec_num_--;
   auto recordNum = page_handle->GetPage()->GetRecordNum();
-  page_handle->GetPage()->SetRecordNum(recordNum--);
+  page_handle->GetPage()->SetRecordNum(--recordNum);
 
-  // 3. if the page is not full after deleting the record
-  if(recordNum < tab_hdr_.rec_per_page_)
-  {
-    // update the first free page id in the file header
-    page_handle->GetPage()->SetNextFreePageId(tab_hdr_.first_free_page_);
-    // and the next page id in the page header
-    tab_hdr_.first_free_page_ = rid.PageID();
-  }
+  std::scoped_lock lock(latch_);
+  tab_hdr_.rec_num_--;
+  // 3. the page has room again, later inserts reuse the slot
+  fsm_.SetHasRoom(rid.PageID(), true);
 
-  // 4. unpin the page
-  buffer_pool_manager_->UnpinPage(table_id_, rid.PageID(), true);
+  // 4. the guard unpins the page
 }
 
 void TableHandle::UpdateRecord(const RID& rid, const Record& record)
 {
   // WSDB_STUDENT_TODO(l1, t3);
+  CheckWritable();
 
-  auto page_handle = FetchPageHandle(rid.PageID());
+  auto guard       = buffer_pool_manager_->FetchPageWrite(table_id_, rid.PageID());
+  auto page_handle = WrapPageHandle(guard);
   auto bitMap = page_handle->GetBitmap();
 
-  // 1. if the slot is empty
+  // 1. if the slot is empty, throw WSDB_RECORD_MISS
   if (!BitMap::GetBit(bitMap, rid.SlotID()))
   {
-    // unpin the page
-    buffer_pool_manager_->UnpinPage(table_id_, rid.PageID(), false);
-    // throw WSDB_RECORD_MISS
     WSDB_THROW(WSDB_RECORD_MISS, fmt::format("Record: {}", rid.SlotID()));
   }
 
   // 2. write slot
   page_handle->WriteSlot(rid.SlotID(), record.GetNullMap(), record.GetData(), true);
 
-  // 3. unpin the page
-  buffer_pool_manager_->UnpinPage(table_id_, rid.PageID(), true);
+  // 3. the guard unpins the page
 }
 
-auto TableHandle::FetchPageHandle(page_id_t page_id) -> PageHandleUptr
+auto TableHandle::CreatePage(BufferAccessStrategy* strategy) -> WritePageGuard
 {
- auto page = buffer_pool_manager_->FetchPage(table_id_, page_id);
- return WrapPageHandle(page);
+ page_id_t page_id;
+ {
+   std::scoped_lock lock(latch_);
+   page_id = fsm_.FindPageWithRoom();
+ }
+ if (page_id == INVALID_PAGE_ID) {
+   return CreateNewPage(strategy);
+ }
+ return buffer_pool_manager_->FetchPageWrite(table_id_, page_id, strategy);
 }
 
-auto TableHandle::CreatePageHandle() -> PageHandleUptr
+auto TableHandle::CreateNewPage(BufferAccessStrategy* strategy) -> WritePageGuard
 {
- if (tab_hdr_.first_free_page_ == INVALID_PAGE_ID) {
-   return CreateNewPageHandle();
+ page_id_t page_id;
+ {
+   std::scoped_lock lock(latch_);
+   if (tab_hdr_.page_num_ == tab_hdr_.allocated_page_num_) {
+     AllocateExtent(1);
+   }
+   page_id = static_cast<page_id_t>(tab_hdr_.page_num_);
+   tab_hdr_.page_num_++;
+   fsm_.Resize(tab_hdr_.page_num_);
+   fsm_.SetHasRoom(page_id, true);
+   buffer_pool_manager_->SetReadAheadLimit(table_id_, tab_hdr_.page_num_);
  }
- auto page = buffer_pool_manager_->FetchPage(table_id_, tab_hdr_.first_free_page_);
- return WrapPageHandle(page);
+ return buffer_pool_manager_->FetchPageWrite(table_id_, page_id, strategy);
 }
 
-auto TableHandle::CreateNewPageHandle() -> PageHandleUptr
+void TableHandle::AllocateExtent(size_t page_num)
 {
- auto page_id = static_cast<page_id_t>(tab_hdr_.page_num_);
- tab_hdr_.page_num_++;
- auto page   = buffer_pool_manager_->FetchPage(table_id_, page_id);
- auto pg_hdl = WrapPageHandle(page);
- page->SetNextFreePageId(tab_hdr_.first_free_page_);
- tab_hdr_.first_free_page_ = page_id;
- return pg_hdl;
+ auto count = (page_num + TABLE_EXTENT_PAGES - 1) / TABLE_EXTENT_PAGES * TABLE_EXTENT_PAGES;
+ disk_manager_->AllocatePages(table_id_, static_cast<page_id_t>(tab_hdr_.allocated_page_num_), count);
+ tab_hdr_.allocated_page_num_ += count;
 }
 
+void TableHandle::CheckWritable() const
+{
+ if (mapped_ != nullptr) {
+   WSDB_THROW(WSDB_UNSUPPORTED_OP, fmt::format("table {} is mapped read-only", GetTableName()));
+ }
+}
+
+void TableHandle::RebuildFreeSpaceMap()
+{
+ fsm_ = FreeSpaceMap(tab_hdr_.page_num_);
+ for (auto page_id = FILE_HEADER_PAGE_ID + 1; static_cast<size_t>(page_id) < tab_hdr_.page_num_; page_id++) {
+   auto rec_num = VisitPage(page_id, nullptr, [&](PageHandle& page_handle) {
+     return BitMap::CountSet(page_handle.GetBitmap(), tab_hdr_.rec_per_page_);
+   });
+   fsm_.SetHasRoom(page_id, rec_num < tab_hdr_.rec_per_page_);
+ }
+}
+
+auto TableHandle::WrapPageHandle(const ReadPageGuard& guard) -> PageHandleUptr
+{
+ // page handles only read through the page while they are used under a read guard
+ return WrapPageHandle(const_cast<Page*>(guard.GetPage()));
+}
+
+auto TableHandle::WrapPageHandle(WritePageGuard& guard) -> PageHandleUptr { return WrapPageHandle(guard.GetPage()); }
+
 auto TableHandle::WrapPageHandle(Page* page) -> PageHandleUptr
 {
  switch (storage_model_) {
@@ -266,42 +322,83 @@ auto TableHandle::GetTableName() const -> std::string
 
 auto TableHandle::GetStorageModel() const -> StorageModel { return storage_model_; }
 
-auto TableHandle::GetFirstRID() -> RID
+auto TableHandle::GetFirstRID(BufferAccessStrategy* strategy) -> RID
 {
  auto page_id = FILE_HEADER_PAGE_ID + 1;
  while (page_id < static_cast<page_id_t>(tab_hdr_.page_num_)) {
-   auto pg_hdl = FetchPageHandle(page_id);
-   auto id = BitMap::FindFirst(pg_hdl->GetBitmap(), tab_hdr_.rec_per_page_, 0, true);
+   auto id = VisitPage(page_id, strategy, [&](PageHandle& pg_hdl) {
+     return BitMap::FindFirst(pg_hdl.GetBitmap(), tab_hdr_.rec_per_page_, 0, true);
+   });
    if (id != tab_hdr_.rec_per_page_) {
-     buffer_pool_manager_->UnpinPage(table_id_, page_id, false);
      return { page_id, static_cast<slot_id_t>(id) };
    }
-   buffer_pool_manager_->UnpinPage(table_id_, page_id, false);
    page_id++;
  }
  return INVALID_RID;
 }
 
-auto TableHandle::GetNextRID(const RID& rid) -> RID
+auto TableHandle::GetNextRID(const RID& rid, BufferAccessStrategy* strategy) -> RID
 {
  auto page_id = rid.PageID();
  auto slot_id = rid.SlotID();
  while (page_id < static_cast<page_id_t>(tab_hdr_.page_num_)) {
-   auto pg_hdl = FetchPageHandle(page_id);
-   slot_id = static_cast<slot_id_t>(BitMap::FindFirst(pg_hdl->GetBitmap(), tab_hdr_.rec_per_page_, slot_id + 1, true));
-   if (slot_id == static_cast<slot_id_t>(tab_hdr_.rec_per_page_)) {
-     buffer_pool_manager_->UnpinPage(table_id_, page_id, false);
-     page_id++;
-     slot_id = -1;
-   }
-   else {
-     buffer_pool_manager_->UnpinPage(table_id_, page_id, false);
+   slot_id = VisitPage(page_id, strategy, [&](PageHandle& pg_hdl) {
+     return static_cast<slot_id_t>(BitMap::FindFirst(pg_hdl.GetBitmap(), tab_hdr_.rec_per_page_, slot_id + 1, true));
+   });
+   if (slot_id != static_cast<slot_id_t>(tab_hdr_.rec_per_page_)) {
      return { page_id, static_cast<slot_id_t>(slot_id) };
    }
+   page_id++;
+   slot_id = -1;
  }
  return INVALID_RID;
 }
 
+void TableHandle::Prefetch(page_id_t first_pid, size_t count, BufferAccessStrategy* strategy)
+{
+ auto end = std::min(static_cast<size_t>(first_pid) + count, tab_hdr_.page_num_);
+ if (static_cast<size_t>(first_pid) >= end) {
+   return;
+ }
+ if (mapped_ != nullptr) {
+   mapped_->WillNeed(first_pid, end - first_pid);
+ } else {
+   buffer_pool_manager_->Prefetch(table_id_, first_pid, end - first_pid, strategy);
+ }
+}
+
+auto TableHandle::CreateScanStrategy() const -> BufferAccessStrategyUptr
+{
+ // mapped tables do not go through the pool
+ if (mapped_ != nullptr || tab_hdr_.page_num_ <= buffer_pool_manager_->GetPoolSize() / BUFFER_RING_THRESHOLD) {
+   return nullptr;
+ }
+ return BufferAccessStrategy::Create(BufferAccessType::BULK_READ);
+}
+
+auto TableHandle::CreateInsertStrategy(size_t rec_num) const -> BufferAccessStrategyUptr
+{
+ auto page_num = (rec_num + tab_hdr_.rec_per_page_ - 1) / tab_hdr_.rec_per_page_;
+ if (page_num <= buffer_pool_manager_->GetPoolSize() / BUFFER_RING_THRESHOLD) {
+   return nullptr;
+ }
+ return BufferAccessStrategy::Create(BufferAccessType::BULK_WRITE);
+}
+
+void TableHandle::ReservePages(size_t rec_num)
+{
+ CheckWritable();
+ std::scoped_lock lock(latch_);
+ auto free_slots = tab_hdr_.rec_per_page_ * (tab_hdr_.page_num_ - 1) - tab_hdr_.rec_num_;
+ if (rec_num <= free_slots) {
+   return;
+ }
+ auto page_num = (rec_num - free_slots + tab_hdr_.rec_per_page_ - 1) / tab_hdr_.rec_per_page_;
+ if (auto preallocated = tab_hdr_.allocated_page_num_ - tab_hdr_.page_num_; page_num > preallocated) {
+   AllocateExtent(page_num - preallocated);
+ }
+}
+
 auto TableHandle::HasField(const std::string& field_name) const -> bool
 {
  return schema_->HasField(table_id_, field_name);
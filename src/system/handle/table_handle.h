@@ -21,12 +21,15 @@
 
 #ifndef WSDB_TABLE_HANDLE_H
 #define WSDB_TABLE_HANDLE_H
+#include <mutex>
 #include <utility>
 
 #include "../../../common/micro.h"
+#include "common/arena.h"
 #include "common/page.h"
 #include "storage/storage.h"
 #include "page_handle.h"
+#include "free_space_map.h"
 
 namespace wsdb {
 
@@ -39,7 +42,8 @@ public:
  TableHandle() = delete;
 
  TableHandle(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, table_id_t table_id,
-     TableHeader &hdr, RecordSchemaUptr &schema, StorageModel storage_model);
+     TableHeader &hdr, RecordSchemaUptr &schema, StorageModel storage_model, FreeSpaceMap fsm = FreeSpaceMap(),
+     MappedFileUptr mapped = nullptr);
 
  /**
     * Get a record by rid
@@ -48,32 +52,45 @@ public:
     * 3. read the record from the slot using page handle
     * 4. unpin the page
     * @param rid
+    * @param strategy buffer access strategy of the scan reading the record, nullptr if none
     * @return record
   */
- auto GetRecord(const RID &rid) -> RecordUptr;
+ auto GetRecord(const RID &rid, BufferAccessStrategy *strategy = nullptr) -> RecordUptr;
 
  /**
     * Get a chunk in page using record schema indicating which columns should be loaded
     * @param pid
     * @param chunk_schema
-    * @return
+    * @param strategy
+    * @return the chunk, its columns point into the page if the table is mapped
+  */
+ auto GetChunk(page_id_t pid, const RecordSchema *chunk_schema, BufferAccessStrategy *strategy = nullptr) -> ChunkUptr;
+
+ /**
+    * Get all records in a page, the page is fetched once and its occupied slots are copied into the arena in slot
+    * order without allocating records
+    * @param pid
+    * @param arena
+    * @param records cleared and filled with views of the records, valid until the arena is reset
+    * @param strategy
   */
- auto GetChunk(page_id_t pid, const RecordSchema *chunk_schema) -> ChunkUptr;
+ void GetPageRecords(
+     page_id_t pid, Arena &arena, std::vector<RecordView> &records, BufferAccessStrategy *strategy = nullptr);
 
  /**
-    * 该函数是在没有free_page的情况下才会调用（？），这样以来first_free_page肯定就是这个新建的page_handle了
     * Insert a record into the table
-    * 1. create a page handle using CreatePageHandle
+    * 1. create a page handle using CreatePage
     * 2. get an empty slot in the page
     * 3. write the record into the slot
     * 4. update the bitmap and the number of records in the page header
-    * 5. if the page is full after inserting the record, update the first free page id in the file header and set the
-    * next page id of the current page
+    * 5. if the page is full after inserting the record, mark it full in the free space map
+    * A page the free space map wrongly has as having room is marked full and the next one is tried
     * 6. unpin the page
     * @param record
+    * @param strategy buffer access strategy of a bulk insert, nullptr if none
     * @return rid of the inserted record
   */
- auto InsertRecord(const Record &record) -> RID;
+ auto InsertRecord(const Record &record, BufferAccessStrategy *strategy = nullptr) -> RID;
 
  /**
     * Insert a record into the table given rid
@@ -89,8 +106,7 @@ public:
     * Delete the record by rid
     * 1. if the slot is empty, unpin the page and throw WSDB_RECORD_MISS
     * 2. update the bitmap and the number of records in the page header
-    * 3. if the page is not full after deleting the record, update the first free page id in the file header and the
-    * next page id in the page header
+    * 3. mark the page as having room in the free space map
     * 4. unpin the page
     * @param rid
   */
@@ -110,37 +126,96 @@ public:
 
  [[nodiscard]] auto GetTableHeader() const -> const TableHeader &;
 
+ [[nodiscard]] auto GetFreeSpaceMap() const -> const FreeSpaceMap & { return fsm_; }
+
  [[nodiscard]] auto GetSchema() const -> const RecordSchema &;
 
  [[nodiscard]] auto GetTableName() const -> std::string;
 
  [[nodiscard]] auto GetStorageModel() const -> StorageModel;
 
- [[nodiscard]] auto GetFirstRID() -> RID;
+ [[nodiscard]] auto GetFirstRID(BufferAccessStrategy *strategy = nullptr) -> RID;
 
- [[nodiscard]] auto GetNextRID(const RID &rid) -> RID;
+ [[nodiscard]] auto GetNextRID(const RID &rid, BufferAccessStrategy *strategy = nullptr) -> RID;
+
+ /**
+    * Hint the buffer pool to read pages [first_pid, first_pid + count) ahead, clipped to the pages of the table
+  */
+ void Prefetch(page_id_t first_pid, size_t count, BufferAccessStrategy *strategy = nullptr);
+
+ /**
+    * A ring for scanning the whole table, tables with no more than 1 / BUFFER_RING_THRESHOLD of the pool's pages
+    * are scanned through the shared pool
+    * @return the strategy, nullptr if the table is small
+  */
+ [[nodiscard]] auto CreateScanStrategy() const -> BufferAccessStrategyUptr;
+
+ /**
+    * A ring for inserting rec_num records at once, nullptr if they fit in 1 / BUFFER_RING_THRESHOLD of the pool
+  */
+ [[nodiscard]] auto CreateInsertStrategy(size_t rec_num) const -> BufferAccessStrategyUptr;
+
+ /**
+    * Preallocate the pages rec_num more records need beyond the free slots of the table, so that a bulk insert
+    * extends the file once instead of extent by extent
+  */
+ void ReservePages(size_t rec_num);
 
  [[nodiscard]] auto HasField(const std::string &field_name) const -> bool;
 
+ /**
+    * Mapped tables are read in place from a read-only mapping of the file instead of through the buffer pool,
+    * inserts, deletes and updates throw WSDB_UNSUPPORTED_OP
+  */
+ [[nodiscard]] auto IsMapped() const -> bool { return mapped_ != nullptr; }
+
 private:
  /**
-    * Fetch the page handle by page id
-    * @param page_id
-    * @return
+    * Call func with the page handle of a page latched for read, or of the page in the mapping if the table is
+    * mapped, the handle is only valid during the call
   */
- auto FetchPageHandle(page_id_t page_id) -> PageHandleUptr;
+ template <typename Func>
+ auto VisitPage(page_id_t pid, BufferAccessStrategy *strategy, Func &&func)
+ {
+   if (mapped_ != nullptr) {
+     Page page;
+     page.SetFilePageId(table_id_, pid);
+     // the mapping is PROT_READ, page handles only read through the page here
+     page.SetData(const_cast<char *>(mapped_->GetPage(pid)));
+     return func(*WrapPageHandle(&page));
+   }
+   auto guard = buffer_pool_manager_->FetchPageRead(table_id_, pid, strategy);
+   return func(*WrapPageHandle(guard));
+ }
 
  /**
-    * Create a page handle that has at least one empty slot
+    * Throw WSDB_UNSUPPORTED_OP if the table is mapped
+  */
+ void CheckWritable() const;
+
+ /**
+    * Latch a page that has at least one empty slot, the lowest one the free space map knows of
     * @return
   */
- auto CreatePageHandle() -> PageHandleUptr;
+ auto CreatePage(BufferAccessStrategy *strategy = nullptr) -> WritePageGuard;
 
  /**
-    * Create a fresh new page handle
+    * Latch a fresh new page, taken from the preallocated pages of the file, an extent is allocated first if there
+    * are none left
     * @return
   */
- auto CreateNewPageHandle() -> PageHandleUptr;
+ auto CreateNewPage(BufferAccessStrategy *strategy = nullptr) -> WritePageGuard;
+
+ /**
+    * Allocate at least page_num pages past the allocated ones, rounded up to whole extents of TABLE_EXTENT_PAGES,
+    * the caller holds latch_
+  */
+ void AllocateExtent(size_t page_num);
+
+ /**
+    * Rebuild the free space map from the slot bitmaps of the pages, for tables whose map is missing or stale
+  */
+ void RebuildFreeSpaceMap();
 
  /**
     * Wrap the page handle according to the storage model
@@ -149,6 +224,13 @@ private:
   */
  auto WrapPageHandle(Page *page) -> PageHandleUptr;
 
+ /**
+    * Wrap the page of a guard, the handle must not outlive the guard
+  */
+ auto WrapPageHandle(const ReadPageGuard &guard) -> PageHandleUptr;
+
+ auto WrapPageHandle(WritePageGuard &guard) -> PageHandleUptr;
+
 private:
  TableHeader tab_hdr_;
  table_id_t  table_id_;
@@ -170,6 +252,14 @@ private:
  // ...
  // | field_m_1, field_m_2, ... , field_m_n |
  std::vector<size_t> field_offset_;
+
+ // pages with empty slots, persisted by TableManager next to the table file
+ FreeSpaceMap   fsm_;
+ MappedFileUptr mapped_;
+
+ // guards fsm_ and the page and record counts in tab_hdr_ against concurrent writers, it is taken while a page
+ // latch is held but never the other way around
+ std::mutex latch_;
 };
 
 DEFINE_UNIQUE_PTR(TableHandle);
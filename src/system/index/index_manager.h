@@ -29,8 +29,11 @@ class IndexManager
 public:
   IndexManager() = delete;
 
-  IndexManager(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager)
-      : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager)
+  /**
+   * @param direct_io open index files with O_DIRECT, see DiskManager::OpenFile
+   */
+  IndexManager(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, bool direct_io = INDEX_DIRECT_IO)
+      : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager), direct_io_(direct_io)
   {}
 
   ~IndexManager() = default;
@@ -47,6 +50,8 @@ public:
 private:
   DiskManager       *disk_manager_;
   BufferPoolManager *buffer_pool_manager_;
+  // passed to DiskManager::OpenFile by OpenIndex
+  bool               direct_io_;
 };
 }  // namespace wsdb
 
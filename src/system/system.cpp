@@ -20,15 +20,123 @@
 //
 
 #include <iostream>
+#include <fstream>
 #include <unistd.h>
 #include <regex>
 #include <csignal>
+#include <cstdlib>
+#include <limits>
+#include <optional>
+#include <sstream>
+#include <unordered_set>
 
 #include "system.h"
 #include "../common/net/net.h"
 #include "context.h"
 
 namespace wsdb {
+
+namespace {
+
+/**
+ * Read "key = value" lines of the config file, '#' starts a comment
+ */
+auto ReadConfigFile(const std::string &file_name) -> std::unordered_map<std::string, std::string>
+{
+  std::unordered_map<std::string, std::string> settings;
+  std::ifstream                                file(file_name);
+  std::string                                  line;
+  std::regex                                   setting_regex(R"(^\s*([A-Za-z_][A-Za-z0-9_]*)\s*=\s*(\S+)\s*$)");
+  while (std::getline(file, line)) {
+    line = line.substr(0, line.find('#'));
+    if (std::smatch match; std::regex_match(line, match, setting_regex)) {
+      settings[match[1]] = match[2];
+    }
+  }
+  return settings;
+}
+
+/**
+ * Look up a setting, the environment variable takes precedence over the config file
+ */
+auto GetSetting(const std::unordered_map<std::string, std::string> &settings, const std::string &key,
+    const char *env_name) -> std::optional<std::string>
+{
+  if (auto env = std::getenv(env_name); env != nullptr) {
+    return env;
+  }
+  if (auto it = settings.find(key); it != settings.end()) {
+    return it->second;
+  }
+  return std::nullopt;
+}
+
+/**
+ * Parse the buffer pool size, either a number of frames or a byte size with a KB/MB/GB suffix
+ */
+auto ParsePoolSize(const std::string &value) -> size_t
+{
+  std::smatch match;
+  if (!std::regex_match(value, match, std::regex(R"(^(\d{1,19})\s*([KkMmGg][Bb]?)?$)"))) {
+    WSDB_FETAL(fmt::format("Invalid buffer pool size: {}", value));
+  }
+  size_t num = std::stoull(match[1]);
+  if (match[2].matched) {
+    size_t unit = 1024;
+    switch (std::tolower(match[2].str()[0])) {
+      case 'g': unit *= 1024; [[fallthrough]];
+      case 'm': unit *= 1024; [[fallthrough]];
+      default: break;
+    }
+    if (num > std::numeric_limits<size_t>::max() / unit) {
+      WSDB_FETAL(fmt::format("Invalid buffer pool size: {}, too large", value));
+    }
+    num = num * unit / PAGE_SIZE;
+  }
+  if (num == 0) {
+    WSDB_FETAL(fmt::format("Invalid buffer pool size: {}, the pool needs at least one frame", value));
+  }
+  return num;
+}
+
+/**
+ * Parse the number of buffer pool shards, a positive number
+ */
+auto ParseShardNum(const std::string &value) -> size_t
+{
+  if (!std::regex_match(value, std::regex(R"(^\d{1,19}$)"))) {
+    WSDB_FETAL(fmt::format("Invalid buffer pool shards: {}", value));
+  }
+  size_t num = std::stoull(value);
+  if (num == 0) {
+    WSDB_FETAL(fmt::format("Invalid buffer pool shards: {}, the pool needs at least one shard", value));
+  }
+  return num;
+}
+
+auto ParseBool(const std::string &value) -> bool
+{
+  return value == "1" || value == "true" || value == "on" || value == "yes";
+}
+
+/**
+ * Parse a comma separated list of names, empty names are skipped
+ */
+auto ParseNameSet(const std::string &value) -> std::unordered_set<std::string>
+{
+  std::unordered_set<std::string> names;
+  std::stringstream               stream(value);
+  std::string                     name;
+  while (std::getline(stream, name, ',')) {
+    if (!name.empty()) {
+      names.insert(name);
+    }
+  }
+  return names;
+}
+
+}  // namespace
+
 SystemManager::SystemManager() = default;
 
 void SystemManager::Init()
@@ -39,12 +147,50 @@ void SystemManager::Init()
   }
   std::filesystem::current_path(DATA_DIR);
 
-  disk_manager_        = std::make_unique<DiskManager>();
+  auto   settings   = ReadConfigFile(CONFIG_FILE);
+  size_t pool_size  = BUFFER_POOL_SIZE;
+  bool   huge_pages = BUFFER_POOL_HUGE_PAGES;
+  if (auto value = GetSetting(settings, "buffer_pool_size", "WSDB_BUFFER_POOL_SIZE"); value.has_value()) {
+    pool_size = ParsePoolSize(*value);
+  }
+  if (auto value = GetSetting(settings, "buffer_pool_huge_pages", "WSDB_BUFFER_POOL_HUGE_PAGES"); value.has_value()) {
+    huge_pages = ParseBool(*value);
+  }
+  size_t shard_num = BUFFER_POOL_SHARD_NUM;
+  if (auto value = GetSetting(settings, "buffer_pool_shards", "WSDB_BUFFER_POOL_SHARDS"); value.has_value()) {
+    shard_num = ParseShardNum(*value);
+  }
+  bool page_checksum = PAGE_CHECKSUM;
+  if (auto value = GetSetting(settings, "page_checksum", "WSDB_PAGE_CHECKSUM"); value.has_value()) {
+    page_checksum = ParseBool(*value);
+  }
+  bool table_direct_io = TABLE_DIRECT_IO;
+  if (auto value = GetSetting(settings, "table_direct_io", "WSDB_TABLE_DIRECT_IO"); value.has_value()) {
+    table_direct_io = ParseBool(*value);
+  }
+  bool index_direct_io = INDEX_DIRECT_IO;
+  if (auto value = GetSetting(settings, "index_direct_io", "WSDB_INDEX_DIRECT_IO"); value.has_value()) {
+    index_direct_io = ParseBool(*value);
+  }
+  auto mapped_tables = ParseNameSet(GetSetting(settings, "mmap_tables", "WSDB_MMAP_TABLES").value_or(MMAP_TABLES));
+
+  disk_manager_        = std::make_unique<DiskManager>(page_checksum);
   log_manager_         = std::make_unique<LogManager>(disk_manager_.get());
-  buffer_pool_manager_ = std::make_unique<BufferPoolManager>(disk_manager_.get(), log_manager_.get(), REPLACER_LRU_K);
+  buffer_pool_manager_ = std::make_unique<BufferPoolManager>(
+      disk_manager_.get(), log_manager_.get(), REPLACER_LRU_K, pool_size, huge_pages, shard_num);
+  WSDB_LOG(fmt::format("Buffer pool: {} frames, {} MB, {} shards{}{}{}{}",
+      pool_size,
+      pool_size * PAGE_SIZE / (1024 * 1024),
+      buffer_pool_manager_->GetShardNum(),
+      huge_pages ? ", huge pages" : "",
+      page_checksum ? ", page checksums" : "",
+      table_direct_io ? ", table direct I/O" : "",
+      index_direct_io ? ", index direct I/O" : ""));
   recovery_            = std::make_unique<Recovery>(disk_manager_.get(), buffer_pool_manager_.get());
-  table_manager_       = std::make_unique<TableManager>(disk_manager_.get(), buffer_pool_manager_.get());
-  index_manager_       = std::make_unique<IndexManager>(disk_manager_.get(), buffer_pool_manager_.get());
+  table_manager_       = std::make_unique<TableManager>(
+      disk_manager_.get(), buffer_pool_manager_.get(), table_direct_io, std::move(mapped_tables));
+  index_manager_       = std::make_unique<IndexManager>(
+      disk_manager_.get(), buffer_pool_manager_.get(), index_direct_io);
   parser_              = std::make_unique<Parser>();
   planner_             = std::make_unique<Planner>();
   executor_            = std::make_unique<Executor>();
@@ -168,7 +314,8 @@ void SystemManager::ClientHandler(int client_fd)
       txn_manager_->SetTransaction(&txn);
       auto gm_tree = parser_->Parse(sql);
       auto plan    = planner_->PlanAST(gm_tree, context.db_);
-      if (plan == nullptr || DoDBPlan(plan, &context) || DoExplainPlan(plan, &context)) {
+      if (plan == nullptr || DoDBPlan(plan, &context) || DoExplainPlan(plan, &context) ||
+          DoShowBufferStatsPlan(plan, &context)) {
         net_controller_->SendOK(client_fd);
       } else {
         /// plan is not a db plan
@@ -238,4 +385,42 @@ bool SystemManager::DoExplainPlan(const std::shared_ptr<AbstractPlan> &plan, Con
   return false;
 }
 
+bool SystemManager::DoShowBufferStatsPlan(const std::shared_ptr<AbstractPlan> &plan, Context *ctx)
+{
+  if (!std::dynamic_pointer_cast<ShowBufferStatsPlan>(plan)) {
+    return false;
+  }
+  const auto &stats = buffer_pool_manager_->GetStats();
+  std::string str   = fmt::format("---\n{}\n", stats.ToString());
+  for (const auto *latency : {&stats.hit_latency_, &stats.miss_latency_}) {
+    str += fmt::format("{} latency: count {}, mean {}ns, p50 <{}ns, p99 <{}ns\n  {}\n",
+        latency == &stats.hit_latency_ ? "hit" : "miss",
+        latency->Count(),
+        latency->MeanNs(),
+        latency->PercentileNs(0.5),
+        latency->PercentileNs(0.99),
+        latency->BucketsToString());
+  }
+  for (const auto &[fid, counters] : buffer_pool_manager_->GetFileStats()) {
+    std::string name;
+    try {
+      name = disk_manager_->GetFileName(fid);
+    } catch (WSDBException_ &e) {
+      name = fmt::format("fid {}", fid);
+    }
+    str += fmt::format("{}: hits {}, misses {}, hit ratio {:.2f}%, evictions {}, dirty writes {} ({} inline), "
+                       "read-ahead {}\n",
+        name,
+        counters.hits_,
+        counters.misses_,
+        counters.HitRatio() * 100,
+        counters.evictions_,
+        counters.dirty_writes_,
+        counters.inline_writes_,
+        counters.readahead_pages_);
+  }
+  net_controller_->SendRawString(ctx->client_fd_, str);
+  return true;
+}
+
 }  // namespace wsdb
\ No newline at end of file
@@ -59,6 +59,8 @@ private:
 
   bool DoExplainPlan(const std::shared_ptr<AbstractPlan> &plan, Context *ctx);
 
+  bool DoShowBufferStatsPlan(const std::shared_ptr<AbstractPlan> &plan, Context *ctx);
+
   void SIGINTHandler(int sig);
 
   void ClientHandler(int client_fd);
@@ -20,9 +20,15 @@
 //
 
 #include "table_manager.h"
+#include <filesystem>
 #include "common/page.h"
 
 namespace wsdb {
+
+// the slots, the bitmap and rec_per_page_ of a table are derived from PAGE_HEADER_SIZE, data pages written under
+// version 1 have the 20-byte header with the checksum field, a change to the page header must bump the version
+static_assert(TABLE_HEADER_VERSION != 1 || PAGE_HEADER_SIZE == 20, "page header changed, bump TABLE_HEADER_VERSION");
+
 void TableManager::CreateTable(
     const std::string &db_name, const std::string &table_name, const RecordSchema &schema, StorageModel storage_model)
 {
@@ -35,11 +41,12 @@ void TableManager::CreateTable(
   auto table_file = disk_manager_->OpenFile(FILE_NAME(db_name, table_name, TAB_SUFFIX));
   // 2. prepare table header
   TableHeader table_header;
-  table_header.page_num_        = 1;
-  table_header.first_free_page_ = INVALID_PAGE_ID;
-  table_header.rec_num_         = 0;
-  table_header.rec_size_        = schema.GetRecordLength();
-  table_header.nullmap_size_    = BITMAP_SIZE(schema.GetFieldCount());
+  table_header.page_num_           = 1;
+  table_header.allocated_page_num_ = 1;
+  table_header.first_free_page_    = INVALID_PAGE_ID;
+  table_header.rec_num_            = 0;
+  table_header.rec_size_           = schema.GetRecordLength();
+  table_header.nullmap_size_       = BITMAP_SIZE(schema.GetFieldCount());
   // n = rec_per_page, PAGE_HDR_SIZE + BITMAP_SIZE(n) + n * (rec_size + nullmap_size) <= PAGE_SIZE
   table_header.rec_per_page_ = (BITMAP_WIDTH * (PAGE_SIZE - PAGE_HEADER_SIZE - 1) + 1) /
                                (1 + (table_header.rec_size_ + table_header.nullmap_size_) * BITMAP_WIDTH);
@@ -49,22 +56,41 @@ void TableManager::CreateTable(
   WriteTableHeader(table_file, table_header, schema);
   // 4. close table file
   disk_manager_->CloseFile(table_file);
+  // 5. the table has no data page yet, so no page has room
+  WriteFreeSpaceMap(db_name, table_name, FreeSpaceMap(table_header.page_num_));
 }
 
 void TableManager::DropTable(const std::string &db_name, const std::string &table_name)
 {
   DiskManager::DestroyFile(FILE_NAME(db_name, table_name, TAB_SUFFIX));
+  if (DiskManager::FileExists(FILE_NAME(db_name, table_name, FSM_SUFFIX))) {
+    DiskManager::DestroyFile(FILE_NAME(db_name, table_name, FSM_SUFFIX));
+  }
 }
 
 TableHandleUptr TableManager::OpenTable(
     const std::string &db_name, const std::string &table_name, StorageModel storage_model)
 {
-  auto table_file    = disk_manager_->OpenFile(FILE_NAME(db_name, table_name, TAB_SUFFIX));
-  auto file_hdr_data = new char[PAGE_SIZE];
-  disk_manager_->ReadPage(table_file, FILE_HEADER_PAGE_ID, file_hdr_data);
+  auto table_file    = disk_manager_->OpenFile(FILE_NAME(db_name, table_name, TAB_SUFFIX), direct_io_);
+  auto file_hdr_data = std::make_unique<char[]>(PAGE_SIZE);
+  disk_manager_->ReadPage(table_file, FILE_HEADER_PAGE_ID, file_hdr_data.get());
   TableHeader      header;
   RecordSchemaUptr schema;
-  char            *cursor = file_hdr_data;
+  char            *cursor = file_hdr_data.get();
+  uint32_t         magic;
+  uint32_t         version;
+  memcpy(&magic, cursor, sizeof(uint32_t));
+  memcpy(&version, cursor + sizeof(uint32_t), sizeof(uint32_t));
+  // a header without the magic predates version 1, its data pages were written in an older page layout as well
+  if (magic != TABLE_HEADER_MAGIC) {
+    disk_manager_->CloseFile(table_file);
+    WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("table {}, header predates version {}", table_name, TABLE_HEADER_VERSION));
+  }
+  if (version != TABLE_HEADER_VERSION) {
+    disk_manager_->CloseFile(table_file);
+    WSDB_THROW(WSDB_FILE_READ_ERROR, fmt::format("table {}, unsupported header version {}", table_name, version));
+  }
+  cursor += 2 * sizeof(uint32_t);
   memcpy(&header, cursor, sizeof(TableHeader));
   cursor += sizeof(TableHeader);
   // parse field schemas, field is arranged as a formatted string:
@@ -82,14 +108,28 @@ TableHandleUptr TableManager::OpenTable(
     fields.push_back({.field_ = field});
   }
   schema = std::make_unique<RecordSchema>(fields);
-  delete[] file_hdr_data;
-  return std::make_unique<TableHandle>(disk_manager_, buffer_pool_manager_, table_file, header, schema, storage_model);
+  MappedFileUptr mapped;
+  if (mapped_tables_.count(table_name) != 0) {
+    mapped = disk_manager_->MapFile(table_file, header.page_num_);
+  }
+  // a missing or stale map is rebuilt by the table handle
+  return std::make_unique<TableHandle>(disk_manager_,
+      buffer_pool_manager_,
+      table_file,
+      header,
+      schema,
+      storage_model,
+      ReadFreeSpaceMap(db_name, table_name),
+      std::move(mapped));
 }
 
 void TableManager::CloseTable(const std::string &db_name, const TableHandle &table_handle)
 {
   // 1. write table header to the zero page
   WriteTableHeader(table_handle.GetTableId(), table_handle.GetTableHeader(), table_handle.GetSchema());
+  if (!table_handle.IsMapped()) {
+    WriteFreeSpaceMap(db_name, table_handle.GetTableName(), table_handle.GetFreeSpaceMap());
+  }
   // 2. flush all pages to disk
   buffer_pool_manager_->FlushAllPages(table_handle.GetTableId());
   // delete all pages
@@ -100,7 +140,9 @@ void TableManager::CloseTable(const std::string &db_name, const TableHandle &tab
 
 void TableManager::WriteTableHeader(table_id_t tid, const TableHeader &header, const RecordSchema &schema)
 {
-  disk_manager_->WriteFile(tid, reinterpret_cast<const char *>(&header), sizeof(TableHeader), SEEK_SET);
+  disk_manager_->WriteFile(tid, reinterpret_cast<const char *>(&TABLE_HEADER_MAGIC), sizeof(uint32_t), SEEK_SET);
+  disk_manager_->WriteFile(tid, reinterpret_cast<const char *>(&TABLE_HEADER_VERSION), sizeof(uint32_t), SEEK_CUR);
+  disk_manager_->WriteFile(tid, reinterpret_cast<const char *>(&header), sizeof(TableHeader), SEEK_CUR);
   // 4. write schema following the table header
   // field_name1:field_type1:field_size1:field_name2:field_type2:field_size2:..
   for (size_t i = 0; i < schema.GetFieldCount(); ++i) {
@@ -111,6 +153,31 @@ void TableManager::WriteTableHeader(table_id_t tid, const TableHeader &header, c
   }
 }
 
+void TableManager::WriteFreeSpaceMap(const std::string &db_name, const std::string &table_name, const FreeSpaceMap &fsm)
+{
+  auto file_name = FILE_NAME(db_name, table_name, FSM_SUFFIX);
+  if (!DiskManager::FileExists(file_name)) {
+    DiskManager::CreateFile(file_name);
+  }
+  auto fsm_file = disk_manager_->OpenFile(file_name);
+  auto data     = fsm.Serialize();
+  disk_manager_->WriteFile(fsm_file, data.data(), data.size(), SEEK_SET);
+  disk_manager_->CloseFile(fsm_file);
+}
+
+auto TableManager::ReadFreeSpaceMap(const std::string &db_name, const std::string &table_name) -> FreeSpaceMap
+{
+  auto file_name = FILE_NAME(db_name, table_name, FSM_SUFFIX);
+  if (!DiskManager::FileExists(file_name)) {
+    return FreeSpaceMap();
+  }
+  auto fsm_file = disk_manager_->OpenFile(file_name);
+  auto data     = std::vector<char>(std::filesystem::file_size(file_name));
+  disk_manager_->ReadFile(fsm_file, data.data(), data.size(), 0, SEEK_SET);
+  disk_manager_->CloseFile(fsm_file);
+  return FreeSpaceMap::Deserialize(data.data(), data.size());
+}
+
 auto TableManager::GetTableId(const std::string &db_name, const std::string &table_name) -> table_id_t
 {
   return disk_manager_->GetFileId(FILE_NAME(db_name, table_name, TAB_SUFFIX));
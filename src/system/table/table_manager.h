@@ -22,6 +22,7 @@
 #ifndef WSDB_TABLE_MANAGER_H
 #define WSDB_TABLE_MANAGER_H
 
+#include <unordered_set>
 #include "storage/disk/disk_manager.h"
 #include "system/handle/table_handle.h"
 
@@ -31,8 +32,16 @@ class TableManager
 {
 public:
   TableManager() = delete;
-  TableManager(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager)
-      : disk_manager_(disk_manager), buffer_pool_manager_(buffer_pool_manager)
+  /**
+   * @param direct_io open table files with O_DIRECT, see DiskManager::OpenFile
+   * @param mapped_tables names of the tables opened read-only through a memory mapping, see TableHandle::IsMapped
+   */
+  TableManager(DiskManager *disk_manager, BufferPoolManager *buffer_pool_manager, bool direct_io = TABLE_DIRECT_IO,
+      std::unordered_set<std::string> mapped_tables = {})
+      : disk_manager_(disk_manager),
+        buffer_pool_manager_(buffer_pool_manager),
+        direct_io_(direct_io),
+        mapped_tables_(std::move(mapped_tables))
   {}
   ~TableManager() = default;
 
@@ -49,9 +58,22 @@ public:
 private:
   void WriteTableHeader(table_id_t tid, const TableHeader &header, const RecordSchema &schema);
 
+  /**
+   * The free space map of a table is kept in a FSM_SUFFIX file next to the table file
+   */
+  void WriteFreeSpaceMap(const std::string &db_name, const std::string &table_name, const FreeSpaceMap &fsm);
+
+  /**
+   * @return the free space map, an empty one if the table has none
+   */
+  auto ReadFreeSpaceMap(const std::string &db_name, const std::string &table_name) -> FreeSpaceMap;
+
 private:
   DiskManager       *disk_manager_;
   BufferPoolManager *buffer_pool_manager_;
+  bool               direct_io_;
+
+  std::unordered_set<std::string> mapped_tables_;
 };
 
 }  // namespace wsdb
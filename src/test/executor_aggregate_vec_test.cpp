@@ -0,0 +1,153 @@
+/*------------------------------------------------------------------------------
+ - Copyright (c) 2024. Websoft research group, Nanjing University.
+ -
+ - This program is free software: you can redistribute it and/or modify
+ - it under the terms of the GNU General Public License as published by
+ - the Free Software Foundation, either version 3 of the License, or
+ - (at your option) any later version.
+ -
+ - This program is distributed in the hope that it will be useful,
+ - but WITHOUT ANY WARRANTY; without even the implied warranty of
+ - MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ - GNU General Public License for more details.
+ -
+ - You should have received a copy of the GNU General Public License
+ - along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ -----------------------------------------------------------------------------*/
+
+#include <gtest/gtest.h>
+#include <optional>
+
+#include "execution/executor_aggregate_vec.h"
+
+namespace wsdb {
+namespace {
+
+const table_id_t TEST_TABLE_ID = 1;
+
+auto MakeField(const std::string &name, FieldType type, AggType agg_type = AGG_NONE) -> RTField
+{
+  RTField field;
+  field.field_.table_id_   = TEST_TABLE_ID;
+  field.field_.field_name_ = name;
+  field.field_.field_type_ = type;
+  field.field_.field_size_ = type == TYPE_FLOAT ? sizeof(float) : sizeof(int32_t);
+  field.is_agg_            = agg_type != AGG_NONE;
+  field.agg_type_          = agg_type;
+  return field;
+}
+
+/**
+ * Rows of (g int, v int) handed out by the row interface, so that NextBatch gathers them into chunks
+ */
+class ValuesExecutor : public AbstractExecutor
+{
+public:
+  explicit ValuesExecutor(std::vector<std::pair<std::optional<int32_t>, std::optional<int32_t>>> rows)
+      : AbstractExecutor(Basic), rows_(std::move(rows))
+  {
+    out_schema_ = std::make_unique<RecordSchema>(
+        std::vector<RTField>{MakeField("g", TYPE_INT), MakeField("v", TYPE_INT)});
+  }
+
+  void Init() override
+  {
+    idx_ = 0;
+    Load();
+  }
+
+  void Next() override
+  {
+    idx_++;
+    Load();
+  }
+
+  [[nodiscard]] auto IsEnd() const -> bool override { return idx_ >= rows_.size(); }
+
+private:
+  void Load()
+  {
+    if (IsEnd()) {
+      record_ = nullptr;
+      return;
+    }
+    auto value = [](const std::optional<int32_t> &v) -> ValueSptr {
+      return v.has_value() ? ValueFactory::CreateIntValue(*v) : ValueFactory::CreateNullValue(TYPE_INT);
+    };
+    std::vector<ValueSptr> values{value(rows_[idx_].first), value(rows_[idx_].second)};
+    record_ = std::make_unique<Record>(out_schema_.get(), values, INVALID_RID);
+  }
+
+  std::vector<std::pair<std::optional<int32_t>, std::optional<int32_t>>> rows_;
+  size_t                                                                 idx_{0};
+};
+
+/**
+ * Aggregate COUNT(*), COUNT(v), SUM(v), AVG(v) and MIN(v) of the rows, grouped by g if group is true
+ * @return the out rows of the aggregation, one string per field, "null" for a null
+ */
+auto Aggregate(std::vector<std::pair<std::optional<int32_t>, std::optional<int32_t>>> rows, bool group)
+    -> std::vector<std::vector<std::string>>
+{
+  std::vector<RTField> aggs{MakeField("v", TYPE_INT, AGG_COUNT_STAR),
+      MakeField("v", TYPE_INT, AGG_COUNT),
+      MakeField("v", TYPE_INT, AGG_SUM),
+      MakeField("v", TYPE_INT, AGG_AVG),
+      MakeField("v", TYPE_INT, AGG_MIN)};
+  std::vector<RTField> groups;
+  if (group) {
+    groups.push_back(MakeField("g", TYPE_INT));
+  }
+  AggregateExecutorVec agg(std::make_unique<ValuesExecutor>(std::move(rows)),
+      std::make_unique<RecordSchema>(aggs),
+      std::make_unique<RecordSchema>(groups));
+
+  std::vector<std::vector<std::string>> result;
+  agg.InitBatch();
+  for (auto chunk = agg.NextBatch(EXECUTOR_BATCH_SIZE); chunk != nullptr; chunk = agg.NextBatch(EXECUTOR_BATCH_SIZE)) {
+    for (size_t row = 0; row < chunk->GetSize(); ++row) {
+      std::vector<std::string> fields;
+      for (size_t col = 0; col < chunk->GetColCount(); ++col) {
+        auto value = chunk->GetValue(col, row);
+        EXPECT_EQ(value->GetType(), TYPE_INT);
+        fields.push_back(value->IsNull() ? "null" : value->ToString());
+      }
+      result.push_back(std::move(fields));
+    }
+  }
+  std::sort(result.begin(), result.end());
+  return result;
+}
+
+using Rows = std::vector<std::vector<std::string>>;
+
+TEST(AggregateExecutorVecTest, AvgOfIntIsTruncatedInt)
+{
+  auto result = Aggregate({{1, 1}, {1, 2}, {2, -3}, {2, -4}, {3, 7}}, true);
+  EXPECT_EQ(result,
+      (Rows{{"1", "2", "2", "3", "1", "1"}, {"2", "2", "2", "-7", "-3", "-4"}, {"3", "1", "1", "7", "7", "7"}}));
+}
+
+TEST(AggregateExecutorVecTest, NullsAreSkipped)
+{
+  auto result = Aggregate({{1, std::nullopt}, {1, 4}, {2, std::nullopt}, {std::nullopt, 5}}, true);
+  EXPECT_EQ(result,
+      (Rows{{"1", "2", "1", "4", "4", "4"},
+          {"2", "1", "0", "null", "null", "null"},
+          {"null", "1", "1", "5", "5", "5"}}));
+}
+
+TEST(AggregateExecutorVecTest, EmptyInputWithoutGroupByIsOneGroup)
+{
+  EXPECT_EQ(Aggregate({}, false), (Rows{{"0", "0", "null", "null", "null"}}));
+}
+
+TEST(AggregateExecutorVecTest, EmptyInputWithGroupByIsNoGroup) { EXPECT_TRUE(Aggregate({}, true).empty()); }
+
+TEST(AggregateExecutorVecTest, WithoutGroupByIsOneGroup)
+{
+  EXPECT_EQ(Aggregate({{1, 3}, {2, std::nullopt}, {3, 4}}, false), (Rows{{"3", "2", "7", "3", "3"}}));
+}
+
+}  // namespace
+}  // namespace wsdb